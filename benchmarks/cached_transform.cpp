@@ -0,0 +1,66 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <itertools/cached_transform.hpp>
+
+#include <cmath>
+
+using namespace itertools;
+
+// An expensive matrix element
+static double matrix_element(long i, long j) {
+  double res = 0;
+  for (int k = 1; k <= 32; ++k) res += std::sin(double(i * k)) * std::cos(double(j * k)) / k;
+  return res;
+}
+
+static auto element = [](auto idx) {
+  auto [i, j] = idx;
+  return matrix_element(i, j);
+};
+
+// ===== Several passes over a transform recompute the elements
+
+static void transform_passes(benchmark::State &state) {
+  long n = state.range(0);
+
+  for (auto _ : state) {
+    auto H = transform(product_range(n, n), element);
+    for (int pass = 0; pass < 4; ++pass) {
+      double sum = 0;
+      for (double h : H) sum += h;
+      benchmark::DoNotOptimize(sum);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n * n);
+}
+BENCHMARK(transform_passes)->Arg(32)->Arg(128);
+
+// ===== Several passes over a cached_transform compute them once
+
+static void cached_transform_passes(benchmark::State &state) {
+  long n = state.range(0);
+
+  for (auto _ : state) {
+    auto H = cached_transform(product_range(n, n), element);
+    for (int pass = 0; pass < 4; ++pass) {
+      double sum = 0;
+      for (double h : H) sum += h;
+      benchmark::DoNotOptimize(sum);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n * n);
+}
+BENCHMARK(cached_transform_passes)->Arg(32)->Arg(128);
@@ -0,0 +1,95 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <itertools/arena.hpp>
+#include <itertools/itertools.hpp>
+
+#include <vector>
+
+using namespace itertools;
+
+// A sweep collects many short temporaries, e.g. one per proposed Monte Carlo move
+static constexpr int n_moves = 256;
+
+static auto move_weight = [](auto idx) {
+  auto [i, j] = idx;
+  return double(i * j);
+};
+
+// ===== Temporaries of a zip with the default allocator
+
+static void collect_zip_default(benchmark::State &state) {
+  long n = state.range(0);
+  std::vector<double> x(n, 1.0), y(n, 2.0);
+
+  for (auto _ : state) {
+    for (int m = 0; m < n_moves; ++m) {
+      auto z = collect<std::vector>(zip(x, y));
+      benchmark::DoNotOptimize(z.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n_moves);
+}
+BENCHMARK(collect_zip_default)->Arg(8)->Arg(64);
+
+// ===== Temporaries of a zip in an arena, reset once per sweep
+
+static void collect_zip_arena(benchmark::State &state) {
+  long n = state.range(0);
+  std::vector<double> x(n, 1.0), y(n, 2.0);
+  auto &ar = thread_local_arena();
+
+  for (auto _ : state) {
+    ar.reset();
+    for (int m = 0; m < n_moves; ++m) {
+      auto z = collect<std::vector>(zip(x, y), arena_allocator<double>{ar});
+      benchmark::DoNotOptimize(z.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n_moves);
+}
+BENCHMARK(collect_zip_arena)->Arg(8)->Arg(64);
+
+// ===== Temporaries of a transformed product with the default allocator
+
+static void collect_transform_default(benchmark::State &state) {
+  long n = state.range(0);
+
+  for (auto _ : state) {
+    for (int m = 0; m < n_moves; ++m) {
+      auto w = collect<std::vector>(transform(product_range(n, 4), move_weight));
+      benchmark::DoNotOptimize(w.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n_moves);
+}
+BENCHMARK(collect_transform_default)->Arg(8)->Arg(64);
+
+// ===== Temporaries of a transformed product in an arena, reset once per sweep
+
+static void collect_transform_arena(benchmark::State &state) {
+  long n   = state.range(0);
+  auto &ar = thread_local_arena();
+
+  for (auto _ : state) {
+    ar.reset();
+    for (int m = 0; m < n_moves; ++m) {
+      auto w = collect<std::vector>(transform(product_range(n, 4), move_weight), arena_allocator<double>{ar});
+      benchmark::DoNotOptimize(w.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n_moves);
+}
+BENCHMARK(collect_transform_arena)->Arg(8)->Arg(64);
@@ -0,0 +1,78 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <itertools/itertools.hpp>
+
+#include <vector>
+
+using namespace itertools;
+
+// ===== Pass over one component of a vector of tuples
+
+static void aos_component_pass(benchmark::State &state) {
+  long n = 1 << state.range(0);
+  std::vector<double> a(n, 1.0), b(n, 2.0), c(n, 3.0);
+  auto aos = make_vector_from_range(transform(zip(a, b, c), [](auto t) { return std::tuple<double, double, double>{t}; }));
+
+  for (auto _ : state) {
+    for (auto &t : aos) std::get<1>(t) = 0.5 * std::get<1>(t) + 1.0;
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * n * sizeof(double));
+}
+BENCHMARK(aos_component_pass)->Arg(12)->Arg(20);
+
+// ===== Pass over one component of a structure of arrays
+
+static void soa_component_pass(benchmark::State &state) {
+  long n = 1 << state.range(0);
+  std::vector<double> a(n, 1.0), b(n, 2.0), c(n, 3.0);
+  auto soa = collect_soa(zip(a, b, c));
+
+  for (auto _ : state) {
+    for (double &x : std::get<1>(soa)) x = 0.5 * x + 1.0;
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * n * sizeof(double));
+}
+BENCHMARK(soa_component_pass)->Arg(12)->Arg(20);
+
+// ===== Update of one component from another through the zip view of a structure of arrays
+
+static void soa_zip_pass(benchmark::State &state) {
+  long n = 1 << state.range(0);
+  std::vector<double> a(n, 1.0), b(n, 2.0), c(n, 3.0);
+  auto soa = collect_soa(zip(a, b, c));
+
+  for (auto _ : state) {
+    for (auto [x, y, z] : zip_soa(soa)) z += 2.0 * x;
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * n * 3 * sizeof(double));
+}
+BENCHMARK(soa_zip_pass)->Arg(12)->Arg(20);
+
+// ===== Collecting a product range
+
+static void collect_soa_product(benchmark::State &state) {
+  long n = 1 << (state.range(0) / 2);
+
+  for (auto _ : state) {
+    auto soa = collect_soa(product_range(n, n));
+    benchmark::DoNotOptimize(std::get<0>(soa).data());
+  }
+  state.SetItemsProcessed(state.iterations() * n * n);
+}
+BENCHMARK(collect_soa_product)->Arg(12)->Arg(20);
@@ -0,0 +1,77 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <itertools/parallel.hpp>
+
+#include <cmath>
+#include <vector>
+
+using namespace itertools;
+
+// A cheap and an expensive function of a pair of indices
+static auto cheap = [](auto idx) {
+  auto [i, j] = idx;
+  return double(i + j);
+};
+
+static auto expensive = [](auto idx) {
+  auto [i, j] = idx;
+  double res  = 0;
+  for (int k = 1; k <= 16; ++k) res += std::sin(double(i * k)) * std::cos(double(j * k));
+  return res;
+};
+
+// ===== Collect without reserving, as for ranges of unknown size
+
+template <typename F> static void push_back_loop(benchmark::State &state, F f) {
+  long n = state.range(0);
+
+  for (auto _ : state) {
+    std::vector<double> vec;
+    for (auto x : transform(product_range(n, n), f)) vec.push_back(x);
+    benchmark::DoNotOptimize(vec.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n * n);
+}
+BENCHMARK_CAPTURE(push_back_loop, cheap, cheap)->Arg(1024)->UseRealTime();
+BENCHMARK_CAPTURE(push_back_loop, expensive, expensive)->Arg(256)->UseRealTime();
+
+// ===== Sequential collection with the size reserved
+
+template <typename F> static void make_vector(benchmark::State &state, F f) {
+  long n = state.range(0);
+
+  for (auto _ : state) {
+    auto vec = make_vector_from_range(transform(product_range(n, n), f));
+    benchmark::DoNotOptimize(vec.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n * n);
+}
+BENCHMARK_CAPTURE(make_vector, cheap, cheap)->Arg(1024)->UseRealTime();
+BENCHMARK_CAPTURE(make_vector, expensive, expensive)->Arg(256)->UseRealTime();
+
+// ===== Parallel collection
+
+template <typename F> static void parallel_make_vector(benchmark::State &state, F f) {
+  long n = state.range(0);
+
+  for (auto _ : state) {
+    auto vec = parallel_make_vector_from_range(transform(product_range(n, n), f));
+    benchmark::DoNotOptimize(vec.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n * n);
+}
+BENCHMARK_CAPTURE(parallel_make_vector, cheap, cheap)->Arg(1024)->UseRealTime();
+BENCHMARK_CAPTURE(parallel_make_vector, expensive, expensive)->Arg(256)->UseRealTime();
@@ -0,0 +1,76 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <itertools/omp_chunk.hpp>
+
+using namespace itertools;
+
+// Some work of n steps
+static void work(long n) {
+  long r = 0;
+  for (long k = 0; k < n; ++k) benchmark::DoNotOptimize(r += k);
+}
+
+// ===== Static chunks
+
+static void chunk_static_uniform(benchmark::State &state) {
+  long N = 1 << state.range(0);
+
+  for (auto _ : state){
+#pragma omp parallel
+    for (auto i: omp_chunk(range(N))){
+      work(64 + 0 * i);
+    }
+  }
+}
+BENCHMARK(chunk_static_uniform)->Arg(16)->UseRealTime();
+
+static void chunk_static_skewed(benchmark::State &state) {
+  long N = 1 << state.range(0);
+
+  for (auto _ : state){
+#pragma omp parallel
+    for (auto i: omp_chunk(range(N))){
+      work(128 * i / N);
+    }
+  }
+}
+BENCHMARK(chunk_static_skewed)->Arg(16)->UseRealTime();
+
+// ===== Dynamic chunks
+
+static void chunk_dynamic_uniform(benchmark::State &state) {
+  long N = 1 << state.range(0);
+
+  for (auto _ : state){
+#pragma omp parallel
+    for (auto i: omp_dynamic_chunks(range(N), 64)){
+      work(64 + 0 * i);
+    }
+  }
+}
+BENCHMARK(chunk_dynamic_uniform)->Arg(16)->UseRealTime();
+
+static void chunk_dynamic_skewed(benchmark::State &state) {
+  long N = 1 << state.range(0);
+
+  for (auto _ : state){
+#pragma omp parallel
+    for (auto i: omp_dynamic_chunks(range(N), 64)){
+      work(128 * i / N);
+    }
+  }
+}
+BENCHMARK(chunk_dynamic_skewed)->Arg(16)->UseRealTime();
@@ -0,0 +1,83 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <itertools/itertools.hpp>
+
+#include <vector>
+
+using namespace itertools;
+
+// ===== Bare loop over every second pair in the first half
+
+static void pipe_bare(benchmark::State &state) {
+  long n = 1 << state.range(0);
+  std::vector<double> a(n, 1.0), b(n, 2.0);
+
+  for (auto _ : state) {
+    double sum = 0;
+    for (long i = 0; i < n / 2; i += 2) sum += 2 * a[i] * b[i] + 1;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n / 4);
+}
+BENCHMARK(pipe_bare)->Arg(10)->Arg(16);
+
+// ===== Nested adapters
+
+static void pipe_nested(benchmark::State &state) {
+  long n = 1 << state.range(0);
+  std::vector<double> a(n, 1.0), b(n, 2.0);
+  auto mul = [](auto t) { return std::get<0>(t) * std::get<1>(t); };
+  auto aff = [](double x) { return 2 * x + 1; };
+
+  for (auto _ : state) {
+    double sum = 0;
+    for (double x : transform(transform(stride(slice(zip(a, b), 0, n / 2), 2), mul), aff)) sum += x;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n / 4);
+}
+BENCHMARK(pipe_nested)->Arg(10)->Arg(16);
+
+// ===== Fused pipeline
+
+static void pipe_fused(benchmark::State &state) {
+  long n = 1 << state.range(0);
+  std::vector<double> a(n, 1.0), b(n, 2.0);
+  auto mul = [](auto t) { return std::get<0>(t) * std::get<1>(t); };
+  auto aff = [](double x) { return 2 * x + 1; };
+
+  for (auto _ : state) {
+    double sum = 0;
+    for (double x : zip(a, b) | slice(0, n / 2) | stride(2) | transform(mul) | transform(aff)) sum += x;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n / 4);
+}
+BENCHMARK(pipe_fused)->Arg(10)->Arg(16);
+
+// ===== Integer range pipeline
+
+static void pipe_range(benchmark::State &state) {
+  long n = 1 << state.range(0);
+
+  for (auto _ : state) {
+    long sum = 0;
+    for (long i : range(n) | slice(n / 4, n / 2) | stride(3)) sum += i;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n / 12);
+}
+BENCHMARK(pipe_range)->Arg(10)->Arg(16);
@@ -31,6 +31,30 @@ static void multi_loop_product(benchmark::State &state) {
 }
 BENCHMARK(multi_loop_product)->ArgsProduct({{8, 10}, {8, 10}});
 
+// ===== Range Loop with small extents
+
+static void multi_loop_product_small(benchmark::State &state) {
+  long a = state.range(0), b = state.range(1), c = state.range(2), d = state.range(3);
+
+  for (auto _ : state){
+    for (auto [i, j, k, l]: product_range(a, b, c, d)){
+      benchmark::DoNotOptimize(i + j + k + l);
+    }
+  }
+}
+BENCHMARK(multi_loop_product_small)->Args({2, 3, 5, 2});
+
+// ===== Range Loop with compile-time extents
+
+static void multi_loop_product_static(benchmark::State &state) {
+  for (auto _ : state){
+    for (auto [i, j, k, l]: product_range<2, 3, 5, 2>()){
+      benchmark::DoNotOptimize(i + j + k + l);
+    }
+  }
+}
+BENCHMARK(multi_loop_product_static);
+
 // ===== Bare Loop
 
 static void multi_loop_bare(benchmark::State &state) {
@@ -0,0 +1,79 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <itertools/itertools.hpp>
+
+#include <vector>
+
+using namespace itertools;
+
+// ===== Matrix transpose B = A^T with row-major traversal
+
+static void transpose_product_range(benchmark::State &state) {
+  long n = 1 << state.range(0);
+  std::vector<double> A(n * n, 1.0), B(n * n);
+
+  for (auto _ : state) {
+    for (auto [i, j] : product_range(n, n)) B[j * n + i] = A[i * n + j];
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * 2 * n * n * sizeof(double));
+}
+BENCHMARK(transpose_product_range)->DenseRange(8, 12, 2);
+
+// ===== Matrix transpose with runtime tiles
+
+static void transpose_tiled_product(benchmark::State &state) {
+  long n = 1 << state.range(0);
+  std::vector<double> A(n * n, 1.0), B(n * n);
+
+  for (auto _ : state) {
+    for (auto [i, j] : tiled_product(std::array{32l, 32l}, range(n), range(n))) B[j * n + i] = A[i * n + j];
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * 2 * n * n * sizeof(double));
+}
+BENCHMARK(transpose_tiled_product)->DenseRange(8, 12, 2);
+
+// ===== Matrix transpose with compile-time tiles
+
+static void transpose_tiled_product_static(benchmark::State &state) {
+  long n = 1 << state.range(0);
+  std::vector<double> A(n * n, 1.0), B(n * n);
+
+  for (auto _ : state) {
+    for (auto [i, j] : tiled_product<32, 32>(range(n), range(n))) B[j * n + i] = A[i * n + j];
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * 2 * n * n * sizeof(double));
+}
+BENCHMARK(transpose_tiled_product_static)->DenseRange(8, 12, 2);
+
+// ===== Bare tiled loop
+
+static void transpose_bare_tiled(benchmark::State &state) {
+  long n = 1 << state.range(0);
+  std::vector<double> A(n * n, 1.0), B(n * n);
+
+  for (auto _ : state) {
+    for (long ii = 0; ii < n; ii += 32)
+      for (long jj = 0; jj < n; jj += 32)
+        for (long i = ii; i < std::min(ii + 32, n); ++i)
+          for (long j = jj; j < std::min(jj + 32, n); ++j) B[j * n + i] = A[i * n + j];
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * 2 * n * n * sizeof(double));
+}
+BENCHMARK(transpose_bare_tiled)->DenseRange(8, 12, 2);
@@ -0,0 +1,84 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <itertools/itertools.hpp>
+
+#include <array>
+#include <vector>
+
+using namespace itertools;
+
+// ===== Plain loop applying a function to the indices
+
+static void transform_bare(benchmark::State &state) {
+  long n = 1 << state.range(0);
+  std::vector<double> a(n, 1.0);
+
+  for (auto _ : state) {
+    for (long i = 0; i < n; ++i) a[i] += double(i) * double(i);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(transform_bare)->Arg(10)->Arg(16);
+
+// ===== Transform of a range with a stateless lambda
+
+static void transform_stateless(benchmark::State &state) {
+  long n = 1 << state.range(0);
+  std::vector<double> a(n, 1.0);
+  auto sq = [](long i) { return double(i) * double(i); };
+
+  for (auto _ : state) {
+    for (auto [x, y] : zip(a, transform(range(n), sq))) x += y;
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(transform_stateless)->Arg(10)->Arg(16);
+
+// ===== Transform of a range with a lambda capturing state
+
+static void transform_capture(benchmark::State &state) {
+  long n = 1 << state.range(0);
+  std::vector<double> a(n, 1.0), w(64, 1.0);
+  auto weighted_sq = [w](long i) { return w[i % 64] * double(i) * double(i); };
+
+  for (auto _ : state) {
+    for (auto [x, y] : zip(a, transform(range(n), weighted_sq))) x += y;
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(transform_capture)->Arg(10)->Arg(16);
+
+// ===== Copying iterators of a transform with a large closure, e.g. to slice it.
+// Every slice copies the 64 captured doubles into its iterators, which this benchmark measures.
+
+static void transform_slices(benchmark::State &state) {
+  long n = 1 << state.range(0);
+  std::array<double, 64> w;
+  w.fill(1.0);
+  auto weighted = transform(range(n), [w](long i) { return w[i % 64] * double(i); });
+
+  for (auto _ : state) {
+    double sum = 0;
+    for (long k = 0; k < n; k += 16)
+      for (double x : slice(weighted, k, k + 16)) sum += x;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(transform_slices)->Arg(10)->Arg(16);
@@ -0,0 +1,109 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <itertools/itertools.hpp>
+
+#include <list>
+#include <vector>
+
+using namespace itertools;
+
+// With GCC 12.2 at -O3, with or without -march=native, zip3_contiguous compiles to the same vectorized
+// inner loop as zip3_bare. Single runs differ by up to 20% on a busy machine, so compare them with
+// --benchmark_repetitions=10 --benchmark_enable_random_interleaving=true.
+
+// ===== Indexed loop over three vectors
+
+static void zip3_bare(benchmark::State &state) {
+  long n = 1 << state.range(0);
+  std::vector<double> a(n, 1.0), b(n, 2.0), c(n, 3.0);
+
+  for (auto _ : state) {
+    for (long i = 0; i < n; ++i) c[i] += a[i] * b[i];
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(zip3_bare)->Arg(10)->Arg(16);
+
+// ===== Zip of three vectors
+
+static void zip3_contiguous(benchmark::State &state) {
+  long n = 1 << state.range(0);
+  std::vector<double> a(n, 1.0), b(n, 2.0), c(n, 3.0);
+
+  for (auto _ : state) {
+    for (auto [x, y, z] : zip(a, b, c)) z += x * y;
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(zip3_contiguous)->Arg(10)->Arg(16);
+
+// ===== Zip of three vectors with a non-contiguous component
+
+static void zip3_generic(benchmark::State &state) {
+  long n = 1 << state.range(0);
+  std::vector<double> a(n, 1.0), b(n, 2.0), c(n, 3.0);
+
+  for (auto _ : state) {
+    for (auto [i, x, y, z] : zip(range(n), a, b, c)) z += x * y;
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(zip3_generic)->Arg(10)->Arg(16);
+
+// ===== Indexed loop using the index
+
+static void enumerate_bare(benchmark::State &state) {
+  long n = 1 << state.range(0);
+  std::vector<double> a(n, 1.0);
+
+  for (auto _ : state) {
+    for (long i = 0; i < n; ++i) a[i] += double(i);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(enumerate_bare)->Arg(10)->Arg(16);
+
+// ===== Enumerate of a vector
+
+static void enumerate_contiguous(benchmark::State &state) {
+  long n = 1 << state.range(0);
+  std::vector<double> a(n, 1.0);
+
+  for (auto _ : state) {
+    for (auto [i, x] : enumerate(a)) x += double(i);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(enumerate_contiguous)->Arg(10)->Arg(16);
+
+// ===== Zip of slices of three vectors
+
+static void zip3_slices(benchmark::State &state) {
+  long n = 1 << state.range(0);
+  std::vector<double> a(n, 1.0), b(n, 2.0), c(n, 3.0);
+
+  for (auto _ : state) {
+    for (auto [x, y, z] : zip(slice(a, 1, n), slice(b, 1, n), slice(c, 1, n))) z += x * y;
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(zip3_slices)->Arg(10)->Arg(16);
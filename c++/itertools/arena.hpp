@@ -0,0 +1,133 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace itertools {
+
+  /**
+   * A monotonic (bump) arena for short-lived temporaries.
+   *
+   * Allocation only advances a pointer within the current block, and deallocation does nothing.
+   * All memory is reclaimed at once by reset. When more than one block was needed, reset replaces
+   * them by a single block of their total size, such that the following sweeps with the same
+   * allocation pattern do not call the system allocator at all.
+   *
+   * An arena must not be used by several threads at once, see thread_local_arena.
+   */
+  class arena {
+    std::vector<std::pair<std::unique_ptr<std::byte[]>, std::size_t>> blocks_;
+    std::byte *ptr_         = nullptr;
+    std::size_t space_      = 0;
+    std::size_t block_size_ = 0;
+
+    // Add a new block of at least min_size bytes, growing the block size geometrically
+    void add_block(std::size_t min_size) {
+      std::size_t size = std::max(block_size_, min_size);
+      blocks_.emplace_back(std::make_unique_for_overwrite<std::byte[]>(size), size);
+      ptr_        = blocks_.back().first.get();
+      space_      = size;
+      block_size_ = 2 * size;
+    }
+
+    public:
+    /// Construct an arena whose first block has the given size in bytes
+    explicit arena(std::size_t block_size = std::size_t{1} << 16) : block_size_(std::max(block_size, std::size_t{64})) {}
+
+    arena(arena const &)            = delete;
+    arena &operator=(arena const &) = delete;
+
+    /// Allocate bytes with the given alignment, valid until the next reset
+    [[nodiscard]] void *allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+      void *p = ptr_;
+      if (not std::align(alignment, bytes, p, space_)) {
+        add_block(bytes + alignment);
+        p = ptr_;
+        std::align(alignment, bytes, p, space_);
+      }
+      ptr_ = static_cast<std::byte *>(p) + bytes;
+      space_ -= bytes;
+      return p;
+    }
+
+    /// Release all allocations at once, keeping the memory for reuse
+    void reset() {
+      if (blocks_.size() > 1) {
+        std::size_t total = capacity();
+        blocks_.clear();
+        block_size_ = total;
+        add_block(total);
+      } else if (not blocks_.empty()) {
+        ptr_   = blocks_[0].first.get();
+        space_ = blocks_[0].second;
+      }
+    }
+
+    /// Total size of the blocks in bytes
+    [[nodiscard]] std::size_t capacity() const {
+      std::size_t total = 0;
+      for (auto const &b : blocks_) total += b.second;
+      return total;
+    }
+
+    /// Number of blocks currently held
+    [[nodiscard]] long n_blocks() const { return long(blocks_.size()); }
+  };
+
+  /// The arena of the calling thread, e.g. to be reset at the beginning of every sweep of a parallel region
+  inline arena &thread_local_arena() {
+    thread_local arena a;
+    return a;
+  }
+
+  /**
+   * Allocator drawing its memory from an arena, for use with standard containers and collect.
+   *
+   * @example
+   *
+   *      auto &ar = thread_local_arena();
+   *      for (int sweep = 0; sweep < n_sweeps; ++sweep) {
+   *        ar.reset();
+   *        auto v = collect<std::vector>(transform(range(N), f), arena_allocator<double>{ar});
+   *        ...
+   *      }
+   */
+  template <typename T> struct arena_allocator {
+    using value_type = T;
+
+    arena *a;
+
+    arena_allocator(arena &a) noexcept : a(&a) {}
+    template <typename U> arena_allocator(arena_allocator<U> const &other) noexcept : a(other.a) {}
+
+    [[nodiscard]] T *allocate(std::size_t n) {
+      if (n > std::size_t(-1) / sizeof(T)) throw std::bad_array_new_length();
+      return static_cast<T *>(a->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *, std::size_t) noexcept {}
+
+    template <typename U> bool operator==(arena_allocator<U> const &other) const noexcept { return a == other.a; }
+  };
+
+  /// A std::vector allocated in an arena
+  template <typename T> using arena_vector = std::vector<T, arena_allocator<T>>;
+
+} // namespace itertools
@@ -0,0 +1,117 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <itertools/itertools.hpp>
+
+#include <algorithm>
+#include <ranges>
+#include <span>
+#include <tuple>
+
+namespace itertools {
+
+  /**
+   * W consecutive indices of an integer range: first, first + step, ..., first + (W - 1) * step.
+   *
+   * The size is a compile-time constant, such that loops over a batch can be unrolled and vectorized.
+   */
+  template <size_t W> struct index_batch {
+    long first = 0, step = 1;
+
+    static constexpr size_t size() noexcept { return W; }
+
+    constexpr long operator[](size_t i) const noexcept { return first + long(i) * step; }
+  };
+
+  namespace detail {
+
+    // Source of index batches for an integer range
+    struct index_batch_source {
+      long first, step, n;
+
+      [[nodiscard]] long size() const { return n; }
+
+      template <size_t W> [[nodiscard]] index_batch<W> at(long k) const { return {first + k * step, step}; }
+    };
+
+    // Source of fixed-size spans for a contiguous range
+    template <typename T> struct span_batch_source {
+      T *data;
+      long n;
+
+      [[nodiscard]] long size() const { return n; }
+
+      template <size_t W> [[nodiscard]] std::span<T, W> at(long k) const { return std::span<T, W>{data + k, W}; }
+    };
+
+    /*
+     * The batch sources of a range, i.e. one source for every argument passed to the function of for_each_batch.
+     *
+     * Supported are ranges, contiguous ranges as well as zip and enumerate of supported ranges.
+     */
+    inline auto batch_sources(range const &r) { return std::tuple{index_batch_source{r.first(), r.step(), r.size()}}; }
+
+    template <typename R>
+       requires(std::ranges::contiguous_range<R> and std::ranges::sized_range<R>)
+    auto batch_sources(R &r) {
+      using T = std::remove_reference_t<std::ranges::range_reference_t<R>>;
+      return std::tuple{span_batch_source<T>{std::ranges::data(r), long(std::ranges::size(r))}};
+    }
+
+    template <typename T> auto batch_sources(enumerated<T> &e) {
+      auto inner = batch_sources(e.x);
+      return std::tuple_cat(std::tuple{index_batch_source{0, 1, std::get<0>(inner).size()}}, inner);
+    }
+
+    template <typename... T> auto batch_sources(zipped<T...> &z) {
+      return std::apply([](auto &...x) { return std::tuple_cat(batch_sources(x)...); }, z.tu);
+    }
+
+  } // namespace detail
+
+  /**
+   * Apply a function to a range in batches of W consecutive elements.
+   *
+   * The function receives one argument per component of the range, covering W consecutive elements:
+   * an index_batch<W> for an integer range or the indices of enumerate, and a std::span<T, W> for a
+   * contiguous range (e.g. std::vector or std::array). Zipped ranges yield one argument per component.
+   * The remaining elements are passed one at a time as batches of size 1.
+   *
+   * Since the batch size is known at compile-time and contiguous data is accessed through
+   * pointers, a simple loop over the batch in f can be vectorized by the compiler.
+   *
+   * @tparam W The batch size, e.g. the simd width
+   * @param r The range, zip or enumerate of integer ranges and contiguous ranges
+   * @param f The function to apply to every batch
+   *
+   * @example
+   *
+   *      for_each_batch<8>(zip(x, y), [a](auto xs, auto ys) {
+   *        for (size_t i = 0; i < xs.size(); ++i) ys[i] += a * xs[i];
+   *      });
+   */
+  template <size_t W, typename R, typename F> void for_each_batch(R &&r, F &&f) {
+    static_assert(W > 0, "for_each_batch requires a positive batch size");
+    auto sources = detail::batch_sources(r);
+    long n       = std::apply([](auto const &...s) { return std::min({s.size()...}); }, sources);
+
+    // The sources are copied into every call, such that stores through the spans cannot alias them
+    long k = 0;
+    for (; k + long(W) <= n; k += W) std::apply([&f, k](auto... s) { f(s.template at<W>(k)...); }, sources);
+    for (; k < n; ++k) std::apply([&f, k](auto... s) { f(s.template at<1>(k)...); }, sources);
+  }
+
+} // namespace itertools
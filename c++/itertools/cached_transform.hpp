@@ -0,0 +1,196 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <itertools/itertools.hpp>
+
+#include <deque>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <vector>
+
+namespace itertools {
+
+  namespace detail {
+
+    /********************* Cached Transform Iterators ********************/
+
+    /*
+     * Iterator of cached_transform over a sized random-access range.
+     *
+     * Every position has a slot in the buffer of the range, which is filled on the first dereference.
+     */
+    template <typename Iter, typename L, typename Value>
+    struct cached_transform_iter : iterator_facade<cached_transform_iter<Iter, L, Value>, Value, weakest_category_t<Iter>, Value const &> {
+
+      Iter it;
+      std::optional<Value> *slot = nullptr;
+      L *lambda                               = nullptr;
+
+      cached_transform_iter() = default;
+      cached_transform_iter(Iter it, std::optional<Value> *slot, L *lambda) : it(std::move(it)), slot(slot), lambda(lambda) {}
+
+      void increment() {
+        ++it;
+        ++slot;
+      }
+
+      void decrement() {
+        --it;
+        --slot;
+      }
+
+      void advance(std::ptrdiff_t n) {
+        it += n;
+        slot += n;
+      }
+
+      [[nodiscard]] std::ptrdiff_t distance_to(cached_transform_iter const &other) const { return other.it - it; }
+
+      template <typename OtherSentinel> [[nodiscard]] std::ptrdiff_t distance_to(sentinel_t<OtherSentinel> const &other) const {
+        return other.it - it;
+      }
+
+      bool operator==(cached_transform_iter const &other) const { return it == other.it; }
+
+      template <typename OtherSentinel> bool operator==(sentinel_t<OtherSentinel> const &other) const { return (it == other.it); }
+
+      Value const &dereference() const {
+        if (not slot->has_value()) slot->emplace((*lambda)(*it));
+        return **slot;
+      }
+
+      Value const *operator->() const { return &dereference(); }
+    };
+
+    /*
+     * Iterator of cached_transform over any other range.
+     *
+     * The values are stored in a deque shared by all copies of the range, which grows as the iterators advance.
+     * The references to the values thus remain valid as long as the range, as required for a forward iterator.
+     */
+    template <typename Iter, typename L, typename Value>
+    struct cached_forward_iter : iterator_facade<cached_forward_iter<Iter, L, Value>, Value, std::forward_iterator_tag, Value const &> {
+
+      Iter it;
+      std::deque<std::optional<Value>> *cache = nullptr;
+      std::size_t pos                         = 0;
+      L *lambda                               = nullptr;
+
+      cached_forward_iter() = default;
+      cached_forward_iter(Iter it, std::deque<std::optional<Value>> *cache, L *lambda) : it(std::move(it)), cache(cache), lambda(lambda) {}
+
+      void increment() {
+        ++it;
+        ++pos;
+      }
+
+      bool operator==(cached_forward_iter const &other) const { return it == other.it; }
+
+      template <typename OtherSentinel> bool operator==(sentinel_t<OtherSentinel> const &other) const { return (it == other.it); }
+
+      Value const &dereference() const {
+        if (cache->size() <= pos) cache->resize(pos + 1);
+        auto &slot = (*cache)[pos];
+        if (not slot.has_value()) slot.emplace((*lambda)(*it));
+        return *slot;
+      }
+
+      Value const *operator->() const { return &dereference(); }
+    };
+
+    // ---------------------------------------------
+
+    template <typename T, typename L> struct cached_transformed {
+      stored_t<T> x;
+      mutable L lambda;
+
+      using base_iterator = decltype(std::cbegin(x));
+      using value_type    = std::remove_cvref_t<std::invoke_result_t<L &, typename std::iterator_traits<base_iterator>::value_type>>;
+
+      // Sized random-access ranges cache all values in a dense buffer, shared by all copies of the range
+      static constexpr bool is_dense =
+         is_sized_v<T> and std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<base_iterator>::iterator_category>;
+
+      using cache_t = std::conditional_t<is_dense, std::vector<std::optional<value_type>>, std::deque<std::optional<value_type>>>;
+      std::shared_ptr<cache_t> cache;
+
+      using const_iterator = std::conditional_t<is_dense, cached_transform_iter<base_iterator, L, value_type>,
+                                                cached_forward_iter<base_iterator, L, value_type>>;
+      using iterator       = const_iterator;
+
+      template <typename U>
+      cached_transformed(U &&x, L lambda) : x(std::forward<U>(x)), lambda(std::move(lambda)) {
+        if constexpr (is_dense)
+          cache = std::make_shared<cache_t>(std::size(this->x));
+        else
+          cache = std::make_shared<cache_t>();
+      }
+
+      /// Number of elements, if the underlying range is sized
+      [[nodiscard]] auto size() const
+         requires(is_sized_v<T>)
+      {
+        return std::size(x);
+      }
+
+      [[nodiscard]] const_iterator cbegin() const noexcept {
+        if constexpr (is_dense)
+          return {std::cbegin(x), cache->data(), &lambda};
+        else
+          return {std::cbegin(x), cache.get(), &lambda};
+      }
+      [[nodiscard]] const_iterator begin() const noexcept { return cbegin(); }
+
+      [[nodiscard]] auto cend() const noexcept { return make_sentinel(std::cend(x)); }
+      [[nodiscard]] auto end() const noexcept { return cend(); }
+    };
+
+  } // namespace detail
+
+  /**
+   * Like transform, but every element is computed at most once.
+   *
+   * For sized random-access ranges, the values are stored lazily in a buffer indexed by position,
+   * which is shared by all copies of the returned range. Dereferencing an iterator repeatedly or
+   * iterating over the range again then reuses the stored values.
+   * Different positions can be filled concurrently, e.g. by threads iterating over omp_chunk of the range,
+   * provided that the lambda can be called concurrently.
+   *
+   * For other ranges, the values are stored in a deque shared in the same way, which grows as the range is traversed.
+   * Unlike the buffer of random-access ranges, it must not be grown by several threads concurrently.
+   *
+   * @param range The range that the lambda is applied to
+   * @param lambda The lambda to apply to the range, typically expensive
+   *
+   * @example
+   *
+   *      auto H = cached_transform(product_range(N, N), [](auto idx) { auto [i, j] = idx; return matrix_element(i, j); });
+   *      for (auto h : H) { ... } // computes the matrix elements
+   *      for (auto h : H) { ... } // reuses them
+   */
+  template <typename T, typename L> auto cached_transform(T &&range, L lambda) {
+    return detail::cached_transformed<T, L>{std::forward<T>(range), std::move(lambda)};
+  }
+
+} // namespace itertools
+
+namespace std::ranges {
+
+  template <typename T, typename L>
+  inline constexpr bool enable_view<itertools::detail::cached_transformed<T, L>> = itertools::detail::is_view_v<T>;
+
+} // namespace std::ranges
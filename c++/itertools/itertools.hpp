@@ -18,14 +18,26 @@
 #define _ITERTOOLS_HPP
 
 #include <tuple>
+#include <algorithm>
+#include <array>
 #include <vector>
+#include <compare>
 #include <iterator>
 #include <iostream>
 #include <exception>
+#include <memory>
 #include <optional>
+#include <ranges>
+#include <cstddef>
 
 namespace itertools {
 
+  // Sentinel_t, used to denote the end of certain ranges
+  template <typename It> struct sentinel_t {
+    It it;
+  };
+  template <typename It> constexpr sentinel_t<It> make_sentinel(It it) { return {std::move(it)}; }
+
   template <class Iter, class Value, class Tag = std::forward_iterator_tag, class Reference = Value &, class Difference = std::ptrdiff_t>
   struct iterator_facade;
 
@@ -42,8 +54,8 @@ namespace itertools {
   struct iterator_facade<Iter, Value, std::forward_iterator_tag, Reference, Difference> {
 
     private:
-    Iter &self() { return static_cast<Iter &>(*this); }
-    [[nodiscard]] Iter const &self() const { return static_cast<const Iter &>(*this); }
+    constexpr Iter &self() { return static_cast<Iter &>(*this); }
+    [[nodiscard]] constexpr Iter const &self() const { return static_cast<const Iter &>(*this); }
 
     public:
     using value_type        = Value;
@@ -52,23 +64,150 @@ namespace itertools {
     using difference_type   = Difference;
     using iterator_category = std::forward_iterator_tag;
 
-    Iter &operator++() {
+    constexpr Iter &operator++() {
+      self().increment();
+      return self();
+    }
+
+    constexpr Iter operator++(int) {
+      Iter c = self();
+      self().increment();
+      return c;
+    }
+
+    constexpr decltype(auto) operator*() const { return self().dereference(); }
+    constexpr decltype(auto) operator->() const { return operator*(); }
+  };
+
+  /*
+   * A helper for the implementation of bidirectional iterators using CRTP
+   *
+   * @tparam Iter
+   * The Iterator Class to be implemented
+   * `Iter` is required to have the following member functions
+   * - value_type [const] [&] dereference()
+   * - void increment()
+   * - void decrement()
+   */
+  template <typename Iter, typename Value, typename Reference, typename Difference>
+  struct iterator_facade<Iter, Value, std::bidirectional_iterator_tag, Reference, Difference> {
+
+    private:
+    constexpr Iter &self() { return static_cast<Iter &>(*this); }
+    [[nodiscard]] constexpr Iter const &self() const { return static_cast<const Iter &>(*this); }
+
+    public:
+    using value_type        = Value;
+    using reference         = Reference;
+    using pointer           = Value *;
+    using difference_type   = Difference;
+    using iterator_category = std::bidirectional_iterator_tag;
+
+    constexpr Iter &operator++() {
+      self().increment();
+      return self();
+    }
+
+    constexpr Iter operator++(int) {
+      Iter c = self();
+      self().increment();
+      return c;
+    }
+
+    constexpr Iter &operator--() {
+      self().decrement();
+      return self();
+    }
+
+    constexpr Iter operator--(int) {
+      Iter c = self();
+      self().decrement();
+      return c;
+    }
+
+    constexpr decltype(auto) operator*() const { return self().dereference(); }
+    constexpr decltype(auto) operator->() const { return operator*(); }
+  };
+
+  /*
+   * A helper for the implementation of random-access iterators using CRTP
+   *
+   * @tparam Iter
+   * The Iterator Class to be implemented
+   * `Iter` is required to have the following member functions
+   * - value_type [const] [&] dereference()
+   * - void increment()
+   * - void decrement()
+   * - void advance(difference_type n)
+   * - difference_type distance_to(Iter const &other)
+   *
+   * Differences to a sentinel are supported if `Iter` additionally provides
+   * - difference_type distance_to(sentinel_t<U> const &s)
+   */
+  template <typename Iter, typename Value, typename Reference, typename Difference>
+  struct iterator_facade<Iter, Value, std::random_access_iterator_tag, Reference, Difference> {
+
+    private:
+    constexpr Iter &self() { return static_cast<Iter &>(*this); }
+    [[nodiscard]] constexpr Iter const &self() const { return static_cast<const Iter &>(*this); }
+
+    public:
+    using value_type        = Value;
+    using reference         = Reference;
+    using pointer           = Value *;
+    using difference_type   = Difference;
+    using iterator_category = std::random_access_iterator_tag;
+
+    constexpr Iter &operator++() {
       self().increment();
       return self();
     }
 
-    Iter operator++(int) {
+    constexpr Iter operator++(int) {
       Iter c = self();
       self().increment();
       return c;
     }
 
-    decltype(auto) operator*() const { return self().dereference(); }
-    decltype(auto) operator->() const { return operator*(); }
+    constexpr Iter &operator--() {
+      self().decrement();
+      return self();
+    }
+
+    constexpr Iter operator--(int) {
+      Iter c = self();
+      self().decrement();
+      return c;
+    }
+
+    constexpr Iter &operator+=(difference_type n) {
+      self().advance(n);
+      return self();
+    }
+
+    constexpr Iter &operator-=(difference_type n) {
+      self().advance(-n);
+      return self();
+    }
+
+    friend constexpr Iter operator+(Iter it, difference_type n) { return it += n; }
+    friend constexpr Iter operator+(difference_type n, Iter it) { return it += n; }
+    friend constexpr Iter operator-(Iter it, difference_type n) { return it -= n; }
+
+    friend constexpr difference_type operator-(Iter const &x, Iter const &y) { return y.distance_to(x); }
+
+    template <typename U> friend constexpr difference_type operator-(sentinel_t<U> const &s, Iter const &it) { return it.distance_to(s); }
+    template <typename U> friend constexpr difference_type operator-(Iter const &it, sentinel_t<U> const &s) { return -it.distance_to(s); }
+
+    friend constexpr std::strong_ordering operator<=>(Iter const &x, Iter const &y) { return 0 <=> x.distance_to(y); }
+
+    constexpr decltype(auto) operator*() const { return self().dereference(); }
+    constexpr decltype(auto) operator->() const { return operator*(); }
+    constexpr decltype(auto) operator[](difference_type n) const { return *(self() + n); }
   };
 
   template <typename Iter, typename EndIter> inline typename std::iterator_traits<Iter>::difference_type distance(Iter first, EndIter last) {
-    if constexpr (std::is_same_v<typename std::iterator_traits<Iter>::iterator_category, std::random_access_iterator_tag>) {
+    if constexpr (std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<Iter>::iterator_category>) {
       // Difference should be defined also for the case that last is a sentinel
       return last - first;
     } else {
@@ -78,17 +217,63 @@ namespace itertools {
     }
   }
 
-  // Sentinel_t, used to denote the end of certain ranges
-  template <typename It> struct sentinel_t {
-    It it;
-  };
-  template <typename It> sentinel_t<It> make_sentinel(It it) { return {std::move(it)}; }
-
   namespace detail {
 
+    // The weakest iterator category among the given iterators, at least forward and at most random-access
+    template <typename... It>
+    using weakest_category_t = std::conditional_t<
+       (std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category> and ...),
+       std::random_access_iterator_tag,
+       std::conditional_t<(std::is_base_of_v<std::bidirectional_iterator_tag, typename std::iterator_traits<It>::iterator_category> and ...),
+                          std::bidirectional_iterator_tag, std::forward_iterator_tag>>;
+
+    /*
+     * A reference to a range, held by the range adapters in place of an lvalue reference member.
+     *
+     * Unlike a reference it can be reassigned, such that the adapters are movable and model std::ranges::view.
+     * Iterating over a const range_ref yields the const iterators of the range, as for a reference member
+     * of a const adapter.
+     */
+    template <typename U> class range_ref {
+      U *ptr;
+
+      public:
+      range_ref(U &r) noexcept : ptr(std::addressof(r)) {}
+
+      [[nodiscard]] U &get() const noexcept { return *ptr; }
+
+      [[nodiscard]] auto begin() noexcept { return std::begin(*ptr); }
+      [[nodiscard]] auto begin() const noexcept { return std::cbegin(*ptr); }
+      [[nodiscard]] auto end() noexcept { return std::end(*ptr); }
+      [[nodiscard]] auto end() const noexcept { return std::cend(*ptr); }
+
+      [[nodiscard]] auto size() const
+         requires requires { std::size(*ptr); }
+      {
+        return std::size(*ptr);
+      }
+
+      friend bool operator==(range_ref const &x, range_ref const &y)
+         requires requires { *x.ptr == *y.ptr; }
+      {
+        return *x.ptr == *y.ptr;
+      }
+    };
+
+    // How an adapter stores a range of type T: by value or, for lvalues, as a range_ref
+    template <typename T> using stored_t = std::conditional_t<std::is_lvalue_reference_v<T>, range_ref<std::remove_reference_t<T>>, T>;
+
+    // True if an adapter storing a range of type T can be iterated independently of the adapter object
+    template <typename T> constexpr bool is_borrowed_v = std::is_lvalue_reference_v<T> or std::ranges::borrowed_range<T>;
+
+    // True if an adapter storing a range of type T is cheap to copy
+    template <typename T> constexpr bool is_view_v = std::is_lvalue_reference_v<T> or std::ranges::view<T>;
+
     /********************* Enumerate Iterator ********************/
 
-    template <typename Iter> struct enum_iter : iterator_facade<enum_iter<Iter>, std::pair<long, typename std::iterator_traits<Iter>::value_type>> {
+    template <typename Iter>
+    struct enum_iter
+       : iterator_facade<enum_iter<Iter>, std::tuple<long, typename std::iterator_traits<Iter>::value_type>, weakest_category_t<Iter>> {
 
       Iter it;
       long i = 0;
@@ -101,6 +286,22 @@ namespace itertools {
         ++i;
       }
 
+      void decrement() {
+        --it;
+        --i;
+      }
+
+      void advance(std::ptrdiff_t n) {
+        it += n;
+        i += n;
+      }
+
+      [[nodiscard]] std::ptrdiff_t distance_to(enum_iter const &other) const { return other.i - i; }
+
+      template <typename OtherSentinel> [[nodiscard]] std::ptrdiff_t distance_to(sentinel_t<OtherSentinel> const &other) const {
+        return other.it - it;
+      }
+
       bool operator==(enum_iter const &other) const { return it == other.it; }
 
       template <typename OtherSentinel> bool operator==(sentinel_t<OtherSentinel> const &other) const { return it == other.it; }
@@ -110,54 +311,195 @@ namespace itertools {
 
     /********************* Transform Iterator ********************/
 
+    /*
+     * Wrapper making a copy-constructible lambda default-constructible and copy-assignable, as required for iterators.
+     * Lambdas with captures are neither, copy-assignment hence reconstructs the held lambda.
+     */
+    template <typename L> struct copyable_box {
+      std::optional<L> opt;
+
+      copyable_box() = default;
+      copyable_box(L const &lambda) : opt(lambda) {}
+
+      copyable_box(copyable_box const &)     = default;
+      copyable_box(copyable_box &&) noexcept = default;
+
+      copyable_box &operator=(copyable_box const &other) {
+        if (this != &other) {
+          if (other.opt)
+            opt.emplace(*other.opt);
+          else
+            opt.reset();
+        }
+        return *this;
+      }
+
+      copyable_box &operator=(copyable_box &&other) noexcept(std::is_nothrow_move_constructible_v<L>) {
+        if (this != &other) {
+          if (other.opt)
+            opt.emplace(std::move(*other.opt));
+          else
+            opt.reset();
+        }
+        return *this;
+      }
+
+      template <typename... X> decltype(auto) operator()(X &&...x) { return (*opt)(std::forward<X>(x)...); }
+    };
+
+    // Semiregular lambdas, e.g. those without captures, are held directly, others in a copyable_box
+    template <typename L> using lambda_holder_t = std::conditional_t<std::semiregular<L>, L, copyable_box<L>>;
+
+    /*
+     * Iterator of transform.
+     *
+     * Every iterator holds its own copy of the lambda, such that it stays valid independently of the transformed
+     * range and a mutable lambda keeps its state per iterator. Stateless lambdas take no space in the iterator.
+     */
     template <typename Iter, typename L, typename Value = std::invoke_result_t<L, typename std::iterator_traits<Iter>::value_type>>
-    struct transform_iter : iterator_facade<transform_iter<Iter, L>, Value> {
+    struct transform_iter : iterator_facade<transform_iter<Iter, L>, Value, weakest_category_t<Iter>> {
 
       Iter it;
-      mutable std::optional<L> lambda;
+      [[no_unique_address]] mutable lambda_holder_t<L> lambda;
 
       transform_iter() = default;
-      transform_iter(Iter it, L lambda) : it(std::move(it)), lambda(std::move(lambda)) {}
+      transform_iter(Iter it, L const &lambda) : it(std::move(it)), lambda(lambda) {}
 
       void increment() { ++it; }
 
-      transform_iter(transform_iter &&)                 = default;
-      transform_iter(transform_iter const &)            = default;
-      transform_iter &operator=(transform_iter &&other) = default;
+      void decrement() { --it; }
 
-      transform_iter &operator=(transform_iter const &other) {
-        it = other.it;
-        if (other.lambda.has_value())
-          lambda.emplace(other.lambda.value());
-        else
-          lambda.reset();
-        return *this;
+      void advance(std::ptrdiff_t n) { it += n; }
+
+      [[nodiscard]] std::ptrdiff_t distance_to(transform_iter const &other) const { return other.it - it; }
+
+      template <typename OtherSentinel> [[nodiscard]] std::ptrdiff_t distance_to(sentinel_t<OtherSentinel> const &other) const {
+        return other.it - it;
       }
 
       bool operator==(transform_iter const &other) const { return it == other.it; }
 
       template <typename OtherSentinel> bool operator==(sentinel_t<OtherSentinel> const &other) const { return (it == other.it); }
 
-      decltype(auto) dereference() const { return (*lambda)(*it); }
+      decltype(auto) dereference() const { return lambda(*it); }
+    };
+
+    /********************* Zip Reference ********************/
+
+    template <typename... R> struct zip_ref;
+
+    template <typename T> constexpr bool is_tuple_or_zip_ref_v                    = false;
+    template <typename... T> constexpr bool is_tuple_or_zip_ref_v<std::tuple<T...>> = true;
+    template <typename... T> constexpr bool is_tuple_or_zip_ref_v<zip_ref<T...>>    = true;
+
+    // True if Tu is a tuple (or zip_ref) whose elements, as obtained by std::get from a Tu&&, satisfy Pred with the R
+    template <template <typename, typename> class Pred, typename Tu, typename... R>
+    constexpr bool tuple_elementwise_v = [] {
+      if constexpr (not is_tuple_or_zip_ref_v<std::remove_cvref_t<Tu>>)
+        return false;
+      else if constexpr (std::tuple_size_v<std::remove_cvref_t<Tu>> != sizeof...(R))
+        return false;
+      else
+        return []<size_t... Is>(std::index_sequence<Is...>) {
+          return (Pred<R, decltype(std::get<Is>(std::declval<Tu>()))>::value and ...);
+        }(std::index_sequence_for<R...>{});
+    }();
+
+    template <typename R, typename U> using is_assignable_through = std::is_assignable<R const &, U>;
+
+    /*
+     * Reference type of zip, i.e. a tuple of the references of the components.
+     *
+     * In C++20 a std::tuple<T &...> prvalue can neither be assigned to when const nor swapped,
+     * which zip_ref adds, such that zipped ranges can be sorted, e.g. with std::ranges::sort.
+     */
+    template <typename... R> struct zip_ref : std::tuple<R...> {
+      using base_t = std::tuple<R...>;
+
+      zip_ref(R... r) : base_t(std::forward<R>(r)...) {}
+
+      template <typename Tu>
+        requires(not std::is_same_v<std::remove_cvref_t<Tu>, zip_ref> and tuple_elementwise_v<std::is_constructible, Tu, R...>)
+      zip_ref(Tu &&t) : zip_ref(std::forward<Tu>(t), std::index_sequence_for<R...>{}) {}
+
+      zip_ref(zip_ref const &)            = default;
+      zip_ref(zip_ref &&)                 = default;
+      zip_ref &operator=(zip_ref const &) = default;
+      zip_ref &operator=(zip_ref &&)      = default;
+
+      // Assign through the references, also to a prvalue as in *it = value
+      template <typename Tu>
+        requires(tuple_elementwise_v<is_assignable_through, Tu, R...>)
+      zip_ref const &operator=(Tu &&t) const {
+        [&]<size_t... Is>(std::index_sequence<Is...>) {
+          ((std::get<Is>(static_cast<base_t const &>(*this)) = std::get<Is>(std::forward<Tu>(t))), ...);
+        }(std::index_sequence_for<R...>{});
+        return *this;
+      }
+
+      // Swap the referenced elements, also of prvalues as in swap(*it1, *it2)
+      friend void swap(zip_ref const &x, zip_ref const &y)
+        requires(tuple_elementwise_v<is_assignable_through, zip_ref, R...>)
+      {
+        [&]<size_t... Is>(std::index_sequence<Is...>) {
+          (std::ranges::swap(std::get<Is>(static_cast<base_t const &>(x)), std::get<Is>(static_cast<base_t const &>(y))), ...);
+        }(std::index_sequence_for<R...>{});
+      }
+
+      private:
+      template <typename Tu, size_t... Is> zip_ref(Tu &&t, std::index_sequence<Is...>) : base_t(std::get<Is>(std::forward<Tu>(t))...) {}
     };
 
     /********************* Zip Iterator ********************/
 
-    template <typename... It> struct zip_iter : iterator_facade<zip_iter<It...>, std::tuple<typename std::iterator_traits<It>::value_type...>> {
+    template <typename... It>
+    struct zip_iter : iterator_facade<zip_iter<It...>, std::tuple<typename std::iterator_traits<It>::value_type...>, weakest_category_t<It...>> {
 
       std::tuple<It...> its;
+      std::ptrdiff_t pos = 0; // Number of steps from the beginning of the zipped range
 
       zip_iter() = default;
       zip_iter(std::tuple<It...> its) : its(std::move(its)) {}
 
       private:
       template <size_t... Is> [[gnu::always_inline]] void increment_all(std::index_sequence<Is...>) { ((void)(++std::get<Is>(its)), ...); }
+      template <size_t... Is> [[gnu::always_inline]] void decrement_all(std::index_sequence<Is...>) { ((void)(--std::get<Is>(its)), ...); }
+      template <size_t... Is> [[gnu::always_inline]] void advance_all(std::ptrdiff_t n, std::index_sequence<Is...>) {
+        ((void)(std::get<Is>(its) += n), ...);
+      }
 
       public:
-      void increment() { increment_all(std::index_sequence_for<It...>{}); }
+      void increment() {
+        increment_all(std::index_sequence_for<It...>{});
+        ++pos;
+      }
+
+      void decrement() {
+        decrement_all(std::index_sequence_for<It...>{});
+        --pos;
+      }
+
+      void advance(std::ptrdiff_t n) {
+        advance_all(n, std::index_sequence_for<It...>{});
+        pos += n;
+      }
+
+      [[nodiscard]] std::ptrdiff_t distance_to(zip_iter const &other) const { return other.pos - pos; }
+
+      // The end of a zip of sized ranges is the length of the shortest range
+      [[nodiscard]] std::ptrdiff_t distance_to(sentinel_t<std::ptrdiff_t> const &other) const { return other.it - pos; }
+
+      // The zipped range ends with its shortest component
+      template <typename OtherSentinel> [[nodiscard]] std::ptrdiff_t distance_to(sentinel_t<OtherSentinel> const &other) const {
+        return [&]<size_t... Is>(std::index_sequence<Is...>) {
+          return std::min({static_cast<std::ptrdiff_t>(std::get<Is>(other.it) - std::get<Is>(its))...});
+        }(std::index_sequence_for<It...>{});
+      }
 
       bool operator==(zip_iter const &other) const { return its == other.its; }
 
+      bool operator==(sentinel_t<std::ptrdiff_t> const &other) const { return pos == other.it; }
+
       template <typename OtherSentinel> bool operator==(sentinel_t<OtherSentinel> const &other) const {
         return [&]<size_t... Is>(std::index_sequence<Is...>) {
           return ((std::get<Is>(its) == std::get<Is>(other.it)) || ...);
@@ -165,24 +507,130 @@ namespace itertools {
       }
 
       template <size_t... Is> [[nodiscard]] auto tuple_map_impl(std::index_sequence<Is...>) const {
-        return std::tuple<decltype(*std::get<Is>(its))...>(*std::get<Is>(its)...);
+        return zip_ref<decltype(*std::get<Is>(its))...>(*std::get<Is>(its)...);
       }
 
       [[nodiscard]] decltype(auto) dereference() const { return tuple_map_impl(std::index_sequence_for<It...>{}); }
+
+      friend auto iter_move(zip_iter const &z) {
+        return [&]<size_t... Is>(std::index_sequence<Is...>) {
+          return zip_ref<std::iter_rvalue_reference_t<It>...>(std::ranges::iter_move(std::get<Is>(z.its))...);
+        }(std::index_sequence_for<It...>{});
+      }
+    };
+
+    /********************* Contiguous Zip Iterator ********************/
+
+    // True if all iterators are contiguous, i.e. the ranges can be accessed through raw pointers
+    template <typename... It> constexpr bool all_contiguous_v = (std::contiguous_iterator<It> and ...);
+
+    // True if all ranges know their size
+    template <typename T> constexpr bool is_sized_v    = requires(T const &x) { std::size(x); };
+    template <typename... T> constexpr bool all_sized_v = (is_sized_v<T> and ...);
+
+    /*
+     * Zip iterator for contiguous ranges.
+     *
+     * All components share a single index into raw pointers, such that a loop over the zipped range
+     * compiles to the same code as an indexed for loop. The range ends at the index of its sentinel.
+     */
+    template <typename... T>
+    struct contiguous_zip_iter : iterator_facade<contiguous_zip_iter<T...>, std::tuple<std::remove_cv_t<T>...>, std::random_access_iterator_tag> {
+
+      std::tuple<T *...> ptrs;
+      std::ptrdiff_t i = 0;
+
+      contiguous_zip_iter() = default;
+      contiguous_zip_iter(std::tuple<T *...> ptrs, std::ptrdiff_t i = 0) : ptrs(ptrs), i(i) {}
+
+      void increment() { ++i; }
+
+      void decrement() { --i; }
+
+      void advance(std::ptrdiff_t n) { i += n; }
+
+      [[nodiscard]] std::ptrdiff_t distance_to(contiguous_zip_iter const &other) const { return other.i - i; }
+
+      [[nodiscard]] std::ptrdiff_t distance_to(sentinel_t<std::ptrdiff_t> const &other) const { return other.it - i; }
+
+      bool operator==(contiguous_zip_iter const &other) const { return i == other.i; }
+
+      bool operator==(sentinel_t<std::ptrdiff_t> const &other) const { return i == other.it; }
+
+      [[nodiscard]] zip_ref<T &...> dereference() const {
+        return std::apply([this](auto *...p) { return zip_ref<T &...>(p[i]...); }, ptrs);
+      }
+
+      friend zip_ref<T &&...> iter_move(contiguous_zip_iter const &z) {
+        return std::apply([&z](auto *...p) { return zip_ref<T &&...>(std::move(p[z.i])...); }, z.ptrs);
+      }
+    };
+
+    /*
+     * Enumerate iterator for a contiguous range.
+     *
+     * The index is shared between the enumeration and the access to the data.
+     */
+    template <typename T>
+    struct contiguous_enum_iter
+       : iterator_facade<contiguous_enum_iter<T>, std::tuple<long, std::remove_cv_t<T>>, std::random_access_iterator_tag> {
+
+      T *ptr = nullptr;
+      long i = 0;
+
+      contiguous_enum_iter() = default;
+      contiguous_enum_iter(T *ptr, long i = 0) : ptr(ptr), i(i) {}
+
+      void increment() { ++i; }
+
+      void decrement() { --i; }
+
+      void advance(std::ptrdiff_t n) { i += n; }
+
+      [[nodiscard]] std::ptrdiff_t distance_to(contiguous_enum_iter const &other) const { return other.i - i; }
+
+      [[nodiscard]] std::ptrdiff_t distance_to(sentinel_t<std::ptrdiff_t> const &other) const { return other.it - i; }
+
+      bool operator==(contiguous_enum_iter const &other) const { return i == other.i; }
+
+      bool operator==(sentinel_t<std::ptrdiff_t> const &other) const { return i == other.it; }
+
+      [[nodiscard]] std::tuple<long, T &> dereference() const { return {i, ptr[i]}; }
     };
 
     /********************* Product Iterator ********************/
 
+    // The product iterator is as strong as its weakest component, but can only step backwards
+    // over a bidirectional component if its end is an iterator of the same type
+    template <typename TupleSentinel, typename... It> struct prod_iter_category {
+      using type = std::forward_iterator_tag;
+    };
+    template <typename... EndIt, typename... It> struct prod_iter_category<std::tuple<EndIt...>, It...> {
+      using type = std::conditional_t<std::is_same_v<weakest_category_t<It...>, std::bidirectional_iterator_tag>
+                                         and not(std::is_same_v<EndIt, It> and ...),
+                                      std::forward_iterator_tag, weakest_category_t<It...>>;
+    };
+
     template <typename TupleSentinel, typename... It>
-    struct prod_iter : iterator_facade<prod_iter<TupleSentinel, It...>, std::tuple<typename std::iterator_traits<It>::value_type...>> {
+    struct prod_iter : iterator_facade<prod_iter<TupleSentinel, It...>, std::tuple<typename std::iterator_traits<It>::value_type...>,
+                                       typename prod_iter_category<TupleSentinel, It...>::type> {
 
       std::tuple<It...> its_begin;
       TupleSentinel its_end;
       std::tuple<It...> its      = its_begin;
       static constexpr long Rank = sizeof...(It);
 
+      using difference_type = std::ptrdiff_t;
+
       prod_iter() = default;
-      prod_iter(std::tuple<It...> its_begin, TupleSentinel its_end) : its_begin(std::move(its_begin)), its_end(std::move(its_end)) {}
+      prod_iter(std::tuple<It...> its_begin, TupleSentinel its_end) : its_begin(std::move(its_begin)), its_end(std::move(its_end)) {
+        // The product is empty if any component is, the iterator then starts at the end of the first component
+        bool is_empty = [this]<size_t... Is>(std::index_sequence<Is...>) {
+          return ((std::get<Is>(its) == std::get<Is>(this->its_end)) || ...);
+        }(std::index_sequence_for<It...>{});
+        if (is_empty)
+          while (not(std::get<0>(its) == std::get<0>(this->its_end))) ++std::get<0>(its);
+      }
 
       template <int N> void _increment() {
         ++std::get<N>(its);
@@ -195,10 +643,77 @@ namespace itertools {
       }
       void increment() { _increment<Rank - 1>(); }
 
+      template <int N> void _decrement() {
+        if constexpr (N > 0) {
+          if (std::get<N>(its) == std::get<N>(its_begin)) {
+            std::get<N>(its) = std::get<N>(its_end);
+            _decrement<N - 1>();
+          }
+        }
+        --std::get<N>(its);
+      }
+      void decrement() {
+        if constexpr (std::is_same_v<typename prod_iter::iterator_category, std::random_access_iterator_tag>)
+          advance(-1);
+        else
+          _decrement<Rank - 1>();
+      }
+
       bool operator==(prod_iter const &other) const { return its == other.its; }
 
       template <typename U> bool operator==(sentinel_t<U> const &s) const { return (s.it == std::get<0>(its)); }
 
+      // ----- Random-access interface, only instantiated if all component iterators are random-access -----
+
+      private:
+      // Number of elements in each of the component ranges
+      template <size_t... Is> [[nodiscard]] std::array<difference_type, Rank> lengths_impl(std::index_sequence<Is...>) const {
+        return {static_cast<difference_type>(std::get<Is>(its_end) - std::get<Is>(its_begin))...};
+      }
+      [[nodiscard]] std::array<difference_type, Rank> lengths() const { return lengths_impl(std::index_sequence_for<It...>{}); }
+
+      // Position of the iterator in the row-major (rightmost fastest) enumeration of the product
+      template <size_t... Is>
+      [[nodiscard]] difference_type linear_index_impl(std::array<difference_type, Rank> const &len, std::index_sequence<Is...>) const {
+        difference_type idx = 0;
+        ((idx = idx * len[Is] + static_cast<difference_type>(std::get<Is>(its) - std::get<Is>(its_begin))), ...);
+        return idx;
+      }
+
+      // Set the component iterators from a linear index by mixed-radix division
+      template <int N> void set_linear_index(std::array<difference_type, Rank> const &len, difference_type idx) {
+        if constexpr (N > 0) {
+          if (len[N] == 0) { // Empty product, only the first component moves
+            std::get<N>(its) = std::get<N>(its_begin);
+            set_linear_index<N - 1>(len, idx);
+            return;
+          }
+          std::get<N>(its) = std::get<N>(its_begin) + idx % len[N];
+          set_linear_index<N - 1>(len, idx / len[N]);
+        } else {
+          std::get<0>(its) = std::get<0>(its_begin) + idx;
+        }
+      }
+
+      public:
+      [[nodiscard]] difference_type linear_index() const { return linear_index_impl(lengths(), std::index_sequence_for<It...>{}); }
+
+      void advance(difference_type n) {
+        if (n == 0) return;
+        auto len = lengths();
+        set_linear_index<Rank - 1>(len, linear_index_impl(len, std::index_sequence_for<It...>{}) + n);
+      }
+
+      [[nodiscard]] difference_type distance_to(prod_iter const &other) const { return other.linear_index() - linear_index(); }
+
+      template <typename U> [[nodiscard]] difference_type distance_to(sentinel_t<U> const &) const {
+        auto len = lengths();
+        auto idx = linear_index_impl(len, std::index_sequence_for<It...>{});
+        difference_type total = 1;
+        for (auto l : len) total *= l;
+        return total - idx;
+      }
+
       private:
       template <size_t... Is> [[gnu::always_inline]] [[nodiscard]] auto tuple_map_impl(std::index_sequence<Is...>) const {
         return std::tuple<decltype(*std::get<Is>(its))...>(*std::get<Is>(its)...);
@@ -210,32 +725,82 @@ namespace itertools {
 
     /********************* Stride Iterator ********************/
 
-    template <typename Iter> struct stride_iter : iterator_facade<stride_iter<Iter>, typename std::iterator_traits<Iter>::value_type> {
+    // Keeps track of its position in the underlying range, such that it never moves beyond its end
+    template <typename Iter>
+    struct stride_iter : iterator_facade<stride_iter<Iter>, typename std::iterator_traits<Iter>::value_type, weakest_category_t<Iter>> {
+
+      // A random-access iterator stays at the beginning and is offset by pos on dereference,
+      // such that pos can step over the end without a bound check.
+      static constexpr bool is_random_access = std::is_same_v<weakest_category_t<Iter>, std::random_access_iterator_tag>;
 
       Iter it;
-      std::ptrdiff_t stride;
+      std::ptrdiff_t pos = 0, size = 0, stride = 1;
 
       stride_iter() = default;
-      stride_iter(Iter it, std::ptrdiff_t stride) : it(it), stride(stride) {
+      stride_iter(Iter it, std::ptrdiff_t pos, std::ptrdiff_t size, std::ptrdiff_t stride) : it(it), pos(pos), size(size), stride(stride) {
         if (stride <= 0) throw std::runtime_error("strided range requires a positive stride");
+        if constexpr (is_random_access) this->pos = n_steps(pos) * stride;
+      }
+
+      private:
+      // Number of strided steps needed to reach the underlying position p
+      [[nodiscard]] std::ptrdiff_t n_steps(std::ptrdiff_t p) const { return (p + stride - 1) / stride; }
+
+      void move_to(std::ptrdiff_t new_pos) {
+        std::advance(it, new_pos - pos);
+        pos = new_pos;
+      }
+
+      public:
+      void increment() {
+        if constexpr (is_random_access)
+          pos += stride;
+        else
+          move_to(std::min(pos + stride, size));
       }
 
-      void increment() { std::advance(it, stride); }
+      void decrement() {
+        if constexpr (is_random_access)
+          pos -= stride;
+        else
+          move_to((n_steps(pos) - 1) * stride);
+      }
+
+      void advance(std::ptrdiff_t n) {
+        if constexpr (is_random_access)
+          pos += n * stride;
+        else
+          move_to(std::min((n_steps(pos) + n) * stride, size));
+      }
+
+      [[nodiscard]] std::ptrdiff_t distance_to(stride_iter const &other) const { return n_steps(other.pos) - n_steps(pos); }
 
-      bool operator==(stride_iter const &other) const { return it == other.it; }
+      bool operator==(stride_iter const &other) const { return pos == other.pos; }
 
-      decltype(auto) dereference() const { return *it; }
+      decltype(auto) dereference() const {
+        if constexpr (is_random_access)
+          return *(it + pos);
+        else
+          return *it;
+      }
     };
 
     /********************* The Wrapper Classes representing the adapted ranges ********************/
 
     template <typename T, typename L> struct transformed {
-      T x;
+      stored_t<T> x;
       L lambda;
 
       using const_iterator = transform_iter<decltype(std::cbegin(x)), L>;
       using iterator       = const_iterator;
 
+      /// Number of elements, if the underlying range is sized
+      [[nodiscard]] auto size() const
+         requires(is_sized_v<T>)
+      {
+        return std::size(x);
+      }
+
       [[nodiscard]] const_iterator cbegin() const noexcept { return {std::cbegin(x), lambda}; }
       [[nodiscard]] const_iterator begin() const noexcept { return cbegin(); }
 
@@ -245,33 +810,74 @@ namespace itertools {
 
     // ---------------------------------------------
 
+    // The iterator of enumerate over an iterator It, with a fast path for contiguous ranges
+    template <typename It>
+    using enum_iter_t =
+       std::conditional_t<all_contiguous_v<It>, contiguous_enum_iter<std::remove_reference_t<std::iter_reference_t<It>>>, enum_iter<It>>;
+
     template <typename T> struct enumerated {
-      T x;
+      stored_t<T> x;
 
-      using iterator       = enum_iter<decltype(std::begin(x))>;
-      using const_iterator = enum_iter<decltype(std::cbegin(x))>;
+      using iterator       = enum_iter_t<decltype(std::begin(x))>;
+      using const_iterator = enum_iter_t<decltype(std::cbegin(x))>;
 
       bool operator==(enumerated const &) const = default;
 
-      [[nodiscard]] iterator begin() noexcept { return std::begin(x); }
-      [[nodiscard]] const_iterator cbegin() const noexcept { return std::cbegin(x); }
+      /// Number of elements, if the underlying range is sized
+      [[nodiscard]] auto size() const
+         requires(is_sized_v<T>)
+      {
+        return std::size(x);
+      }
+
+      private:
+      template <typename It, typename S> static auto make_end(It const &first, S const &last) {
+        if constexpr (all_contiguous_v<It>)
+          return make_sentinel(std::ptrdiff_t(last - first));
+        else
+          return make_sentinel(last);
+      }
+
+      public:
+      [[nodiscard]] iterator begin() noexcept {
+        if constexpr (all_contiguous_v<decltype(std::begin(x))>)
+          return {std::to_address(std::begin(x))};
+        else
+          return std::begin(x);
+      }
+      [[nodiscard]] const_iterator cbegin() const noexcept {
+        if constexpr (all_contiguous_v<decltype(std::cbegin(x))>)
+          return {std::to_address(std::cbegin(x))};
+        else
+          return std::cbegin(x);
+      }
       [[nodiscard]] const_iterator begin() const noexcept { return cbegin(); }
 
-      [[nodiscard]] auto end() noexcept { return make_sentinel(std::end(x)); }
-      [[nodiscard]] auto cend() const noexcept { return make_sentinel(std::cend(x)); }
+      [[nodiscard]] auto end() noexcept { return make_end(std::begin(x), std::end(x)); }
+      [[nodiscard]] auto cend() const noexcept { return make_end(std::cbegin(x), std::cend(x)); }
       [[nodiscard]] auto end() const noexcept { return cend(); }
     };
 
     // ---------------------------------------------
 
     template <typename... T> struct zipped {
-      std::tuple<T...> tu; // T can be a ref.
+      std::tuple<stored_t<T>...> tu;
 
-      using seq_t          = std::index_sequence_for<T...>;
-      using iterator       = zip_iter<decltype(std::begin(std::declval<T &>()))...>;
-      using const_iterator = zip_iter<decltype(std::cbegin(std::declval<T &>()))...>;
+      using seq_t = std::index_sequence_for<T...>;
 
-      template <typename... U> zipped(U &&...ranges) : tu{std::forward<U>(ranges)...} {}
+      private:
+      // The zip iterator over the iterators It, with a fast path for contiguous ranges
+      template <typename... It>
+      using zip_iter_t = std::conditional_t<all_contiguous_v<It...>, contiguous_zip_iter<std::remove_reference_t<std::iter_reference_t<It>>...>,
+                                            zip_iter<It...>>;
+
+      public:
+      using iterator       = zip_iter_t<decltype(std::begin(std::declval<T &>()))...>;
+      using const_iterator = zip_iter_t<decltype(std::cbegin(std::declval<T &>()))...>;
+
+      template <typename... U>
+         requires(sizeof...(U) == sizeof...(T) and not(std::is_same_v<std::remove_cvref_t<U>, zipped> and ...))
+      zipped(U &&...ranges) : tu{std::forward<U>(ranges)...} {}
 
       bool operator==(zipped const &) const = default;
 
@@ -284,20 +890,52 @@ namespace itertools {
         return std::make_tuple(f(std::get<Is>(tu))...);
       }
 
+      // Length of the shortest range
+      [[nodiscard]] std::ptrdiff_t min_size() const {
+        auto size_of = [](auto const &x) {
+          if constexpr (is_sized_v<decltype(x)>)
+            return std::ptrdiff_t(std::size(x));
+          else
+            return std::ptrdiff_t(std::cend(x) - std::cbegin(x));
+        };
+        return std::apply([&](auto const &...x) { return std::min({size_of(x)...}); }, tu);
+      }
+
       public:
+      /// Number of elements, i.e. the size of the shortest range, if all ranges are sized
+      [[nodiscard]] std::ptrdiff_t size() const
+         requires(all_sized_v<T...>)
+      {
+        return min_size();
+      }
+
       [[nodiscard]] iterator begin() noexcept {
-        return tuple_map([](auto &&x) { return std::begin(x); }, seq_t{});
+        if constexpr (all_contiguous_v<decltype(std::begin(std::declval<T &>()))...>)
+          return tuple_map([](auto &&x) { return std::to_address(std::begin(x)); }, seq_t{});
+        else
+          return tuple_map([](auto &&x) { return std::begin(x); }, seq_t{});
       }
       [[nodiscard]] const_iterator cbegin() const noexcept {
-        return tuple_map([](auto &&x) { return std::cbegin(x); }, seq_t{});
+        if constexpr (all_contiguous_v<decltype(std::cbegin(std::declval<T &>()))...>)
+          return tuple_map([](auto &&x) { return std::to_address(std::cbegin(x)); }, seq_t{});
+        else
+          return tuple_map([](auto &&x) { return std::cbegin(x); }, seq_t{});
       }
       [[nodiscard]] const_iterator begin() const noexcept { return cbegin(); }
 
+      // For contiguous or sized ranges, the end is the length of the shortest range.
+      // The iterator then compares a single counter instead of every component.
       [[nodiscard]] auto end() noexcept {
-        return make_sentinel(tuple_map([](auto &&x) { return std::end(x); }, seq_t{}));
+        if constexpr (all_contiguous_v<decltype(std::begin(std::declval<T &>()))...> or all_sized_v<T...>)
+          return make_sentinel(min_size());
+        else
+          return make_sentinel(tuple_map([](auto &&x) { return std::end(x); }, seq_t{}));
       }
       [[nodiscard]] auto cend() const noexcept {
-        return make_sentinel(tuple_map([](auto &&x) { return std::cend(x); }, seq_t{}));
+        if constexpr (all_contiguous_v<decltype(std::cbegin(std::declval<T &>()))...> or all_sized_v<T...>)
+          return make_sentinel(min_size());
+        else
+          return make_sentinel(tuple_map([](auto &&x) { return std::cend(x); }, seq_t{}));
       }
       [[nodiscard]] auto end() const noexcept { return cend(); }
     };
@@ -305,12 +943,14 @@ namespace itertools {
     // ---------------------------------------------
 
     template <typename... T> struct multiplied {
-      std::tuple<T...> tu; // T can be a ref.
+      std::tuple<stored_t<T>...> tu;
 
       using iterator       = prod_iter<std::tuple<decltype(std::end(std::declval<T &>()))...>, decltype(std::begin(std::declval<T &>()))...>;
       using const_iterator = prod_iter<std::tuple<decltype(std::cend(std::declval<T &>()))...>, decltype(std::cbegin(std::declval<T &>()))...>;
 
-      template <typename... U> multiplied(U &&...ranges) : tu{std::forward<U>(ranges)...} {}
+      template <typename... U>
+         requires(sizeof...(U) == sizeof...(T) and not(std::is_same_v<std::remove_cvref_t<U>, multiplied> and ...))
+      multiplied(U &&...ranges) : tu{std::forward<U>(ranges)...} {}
 
       bool operator==(multiplied const &) const = default;
 
@@ -331,6 +971,13 @@ namespace itertools {
       [[nodiscard]] auto end() noexcept { return make_sentinel(std::end(std::get<0>(tu))); }
       [[nodiscard]] auto cend() const noexcept { return make_sentinel(std::cend(std::get<0>(tu))); }
       [[nodiscard]] auto end() const noexcept { return cend(); }
+
+      /// Number of elements in the product, i.e. the product of the sizes of all ranges, if all ranges are sized
+      [[nodiscard]] std::ptrdiff_t size() const
+         requires(all_sized_v<T...>)
+      {
+        return std::apply([](auto const &...x) { return (std::ptrdiff_t{1} * ... * static_cast<std::ptrdiff_t>(std::size(x))); }, tu);
+      }
     };
 
     template <typename... T> multiplied(T &&...) -> multiplied<std::decay_t<T>...>;
@@ -338,32 +985,35 @@ namespace itertools {
     // ---------------------------------------------
 
     template <typename T> struct sliced {
-      T x;
-      std::ptrdiff_t start_idx, end_idx;
+      stored_t<T> x;
+      std::ptrdiff_t start_idx, end_idx; // Clamped to the size of x on construction
 
       using iterator       = decltype(std::begin(x));
       using const_iterator = decltype(std::cbegin(x));
 
+      template <typename U> sliced(U &&r, std::ptrdiff_t start, std::ptrdiff_t end) : x(std::forward<U>(r)) {
+        std::ptrdiff_t total_size = itertools::distance(std::cbegin(x), std::cend(x));
+        start_idx                 = std::min(std::max(start, std::ptrdiff_t{0}), total_size);
+        end_idx                   = std::min(std::max(end, start_idx), total_size);
+      }
+
       bool operator==(sliced const &) const = default;
 
-      [[nodiscard]] std::ptrdiff_t size() const {
-        std::ptrdiff_t total_size = distance(std::cbegin(x), std::cend(x));
-        return std::min(total_size, end_idx) - start_idx;
-      }
+      [[nodiscard]] std::ptrdiff_t size() const noexcept { return end_idx - start_idx; }
 
       [[nodiscard]] iterator begin() noexcept { return std::next(std::begin(x), start_idx); }
       [[nodiscard]] const_iterator cbegin() const noexcept { return std::next(std::cbegin(x), start_idx); }
       [[nodiscard]] const_iterator begin() const noexcept { return cbegin(); }
 
-      [[nodiscard]] iterator end() noexcept { return std::next(begin(), size()); }
-      [[nodiscard]] const_iterator cend() const noexcept { return std::next(cbegin(), size()); }
+      [[nodiscard]] iterator end() noexcept { return std::next(std::begin(x), end_idx); }
+      [[nodiscard]] const_iterator cend() const noexcept { return std::next(std::cbegin(x), end_idx); }
       [[nodiscard]] const_iterator end() const noexcept { return cend(); }
     };
 
     // ---------------------------------------------
 
     template <typename T> struct strided {
-      T x;
+      stored_t<T> x;
       std::ptrdiff_t stride;
 
       using iterator       = stride_iter<decltype(std::begin(x))>;
@@ -371,17 +1021,49 @@ namespace itertools {
 
       bool operator==(strided const &) const = default;
 
-      [[nodiscard]] iterator begin() noexcept { return {std::begin(x), stride}; }
-      [[nodiscard]] const_iterator cbegin() const noexcept { return {std::cbegin(x), stride}; }
+      private:
+      [[nodiscard]] std::ptrdiff_t underlying_size() const {
+        if constexpr (is_sized_v<T>)
+          return std::size(x);
+        else
+          return itertools::distance(std::cbegin(x), std::cend(x));
+      }
+
+      public:
+      /// Number of elements in the strided range, if the underlying range is sized
+      [[nodiscard]] std::ptrdiff_t size() const
+         requires(is_sized_v<T>)
+      {
+        return (underlying_size() + stride - 1) / stride;
+      }
+
+      [[nodiscard]] iterator begin() noexcept { return {std::begin(x), 0, underlying_size(), stride}; }
+      [[nodiscard]] const_iterator cbegin() const noexcept { return {std::cbegin(x), 0, underlying_size(), stride}; }
       [[nodiscard]] const_iterator begin() const noexcept { return cbegin(); }
 
+      private:
+      // The iterator to the end of the underlying range, which might end with a sentinel
+      template <typename It, typename S> static It end_iterator(It first, S last, std::ptrdiff_t n) {
+        if constexpr (std::is_same_v<It, S>)
+          return last;
+        else
+          return std::next(first, n);
+      }
+
+      public:
       [[nodiscard]] iterator end() noexcept {
-        std::ptrdiff_t end_idx = distance(std::cbegin(x), std::cend(x));
-        return std::next(std::end(x), stride - end_idx % stride);
+        auto n = underlying_size();
+        if constexpr (iterator::is_random_access)
+          return {std::begin(x), n, n, stride};
+        else
+          return {end_iterator(std::begin(x), std::end(x), n), n, n, stride};
       }
       [[nodiscard]] const_iterator cend() const noexcept {
-        std::ptrdiff_t end_idx = distance(std::cbegin(x), std::cend(x));
-        return std::next(std::cend(x), stride - end_idx % stride);
+        auto n = underlying_size();
+        if constexpr (const_iterator::is_random_access)
+          return {std::cbegin(x), n, n, stride};
+        else
+          return {end_iterator(std::cbegin(x), std::cend(x), n), n, n, stride};
       }
       [[nodiscard]] const_iterator end() const noexcept { return cend(); }
     };
@@ -394,6 +1076,10 @@ namespace itertools {
    * Transform (lazy)applies a unary lambda function to every
    * element of a range. It returns itself a range.
    *
+   * Every iterator holds its own copy of the lambda, a mutable lambda hence keeps its state per iterator.
+   * Copying an iterator, e.g. in slice or omp_chunk, copies the captures, which should be kept small,
+   * e.g. by capturing large data by reference.
+   *
    * @param range The range that the lambda is applied to
    * @param range The lambda to apply to the range
    */
@@ -420,13 +1106,17 @@ namespace itertools {
    *
    * The function returns a iterable lazy object. When iterated upon, 
    * this object yields a tuple of the objects in the ranges. 
+   * Zips of random-access ranges of assignable elements can be sorted with std::ranges::sort,
+   * which permutes all ranges together. Since end() is a sentinel, std::sort needs an end iterator,
+   * e.g. std::sort(z.begin(), z.begin() + z.size()).
    *
    * @tparam R Type of the ranges
    * @param ranges 
    *     The ranges to zip. 
    *
    *     .. warning::
-   *          The ranges have to be equal lengths or behaviour is undefined.
+   *          The ranges have to be equal lengths or behaviour is undefined,
+   *          unless all of them are sized. The zip then ends with the shortest range.
    */
   template <typename... R> detail::zipped<R...> zip(R &&...ranges) { return {std::forward<R>(ranges)...}; }
 
@@ -455,27 +1145,37 @@ namespace itertools {
    */
   template <typename... T> detail::multiplied<T...> product(T &&...ranges) { return {std::forward<T>(ranges)...}; }
 
+  class range;
+
   /**
    * Lazy-slice a range.
-   * This function returns itself a slice of the initial range
+   * This function returns itself a slice of the initial range.
+   * The slice of an integer range is again a range, see the overload for range.
    *
    * @param range The range to slice
    * @param start_idx The index to start the slice at
    * @param end_idx The index one past the end of the sliced range
    */
-  template <typename T> detail::sliced<T> slice(T &&range, std::ptrdiff_t start_idx, std::ptrdiff_t end_idx) {
+  template <typename T>
+     requires(not std::is_same_v<std::remove_cvref_t<T>, range>)
+  detail::sliced<T> slice(T &&range, std::ptrdiff_t start_idx, std::ptrdiff_t end_idx) {
     return {std::forward<T>(range), start_idx, std::max(start_idx, end_idx)};
   }
 
   /**
    * Lazy-stride a range.
    * This function returns itself a subrange of the initial range
-   * by considering only every N-th element
+   * by considering only every N-th element.
+   * The stride of an integer range is again a range, see the overload for range.
    *
    * @param range The range to take the subrange of
-   * @param stride The numer of elements to skip
+   * @param stride The number of elements to skip
    */
-  template <typename T> detail::strided<T> stride(T &&range, std::ptrdiff_t stride) { return {std::forward<T>(range), stride}; }
+  template <typename T>
+     requires(not std::is_same_v<std::remove_cvref_t<T>, range>)
+  detail::strided<T> stride(T &&range, std::ptrdiff_t stride) {
+    return {std::forward<T>(range), stride};
+  }
 
   /********************* Some factory functions ********************/
 
@@ -491,16 +1191,121 @@ namespace itertools {
     return detail::make_product_impl(arr, std::make_index_sequence<N>{});
   }
 
-  template <typename R> auto make_vector_from_range(R const &r) {
-    std::vector<std::decay_t<decltype(*(std::begin(r)))>> vec{}; // decltype returns a &
-    if constexpr (std::is_same_v<decltype(std::cbegin(r)), decltype(std::cend(r))>) {
-      auto total_size = distance(std::cbegin(r), std::cend(r));
-      vec.reserve(total_size);
+  namespace detail {
+    // The type of the elements of a range
+    template <typename R> using range_value_t = std::decay_t<decltype(*std::cbegin(std::declval<R const &>()))>;
+
+    // The vector holding the component I of the tuple-like values V in collect_soa
+    template <typename V, size_t I, typename Alloc, typename T = std::decay_t<std::tuple_element_t<I, V>>>
+    using soa_column_t = std::vector<T, typename std::allocator_traits<Alloc>::template rebind_alloc<T>>;
+  } // namespace detail
+
+  /**
+   * Collect the elements of a range into a container with a given allocator.
+   *
+   * The memory is reserved up front if the container supports it and the size of the range is known,
+   * i.e. if it has a size() or random-access iterators. The elements are then constructed in place
+   * at the end of the container, or inserted for containers without emplace_back such as std::set.
+   *
+   * @tparam Container The type of the container, e.g. std::vector<double, A>
+   * @param r The range to collect
+   * @param alloc The allocator of the container, e.g. an arena_allocator
+   *
+   * @example
+   *
+   *      auto v = collect<std::pmr::vector<double>>(transform(range(N), f), &memory_resource);
+   */
+  template <typename Container, typename R> Container collect(R const &r, typename Container::allocator_type const &alloc = {}) {
+    Container c(alloc);
+    if constexpr (requires { c.reserve(0); }) {
+      using category = typename std::iterator_traits<decltype(std::cbegin(r))>::iterator_category;
+      if constexpr (detail::is_sized_v<R>) {
+        c.reserve(std::size(r));
+      } else if constexpr (std::is_base_of_v<std::random_access_iterator_tag, category>
+                           or std::is_same_v<decltype(std::cbegin(r)), decltype(std::cend(r))>) {
+        c.reserve(distance(std::cbegin(r), std::cend(r)));
+      }
+    }
+    for (auto const &x : r) {
+      if constexpr (requires { c.emplace_back(x); })
+        c.emplace_back(x);
+      else
+        c.insert(c.end(), x);
     }
-    for (auto const &x : r) vec.emplace_back(x);
-    return vec;
+    return c;
+  }
+
+  /**
+   * Collect the elements of a range into a container template, e.g. std::vector or std::deque.
+   *
+   * The element type is that of the range and the allocator is rebound to it.
+   *
+   * @tparam C The container template
+   * @param r The range to collect
+   * @param alloc The allocator of the container, for any element type
+   *
+   * @example
+   *
+   *      auto v = collect<std::vector>(zip(a, b), arena_allocator<std::byte>{thread_local_arena()});
+   */
+  template <template <typename...> class C, typename R, typename Alloc = std::allocator<detail::range_value_t<R>>>
+  auto collect(R const &r, Alloc const &alloc = {}) {
+    using alloc_t = typename std::allocator_traits<Alloc>::template rebind_alloc<detail::range_value_t<R>>;
+    return collect<C<detail::range_value_t<R>, alloc_t>>(r, alloc_t(alloc));
+  }
+
+  /**
+   * Collect a range of tuples into one vector per component (structure of arrays).
+   *
+   * Unlike a vector of tuples, every component is stored contiguously, such that later passes over
+   * a single component stream through memory and vectorize. The memory is reserved up front if the
+   * size of the range is known, see collect.
+   *
+   * @param r The range of tuple-like elements to collect, e.g. a zip or a product_range
+   * @param alloc The allocator of the vectors, for any element type
+   * @return A std::tuple of std::vector, one for each component
+   *
+   * @example
+   *
+   *      auto cols = collect_soa(product_range(N, M));
+   *      for (auto [i, j] : zip_soa(cols)) { ... }
+   *      auto const &is = std::get<0>(cols);
+   */
+  template <typename R, typename Alloc = std::allocator<std::byte>> auto collect_soa(R const &r, Alloc const &alloc = {}) {
+    using value_t = detail::range_value_t<R>;
+    return [&]<size_t... Is>(std::index_sequence<Is...>) {
+      std::tuple<detail::soa_column_t<value_t, Is, Alloc>...> columns{typename detail::soa_column_t<value_t, Is, Alloc>::allocator_type(alloc)...};
+      using category = typename std::iterator_traits<decltype(std::cbegin(r))>::iterator_category;
+      if constexpr (detail::is_sized_v<R>) {
+        (std::get<Is>(columns).reserve(std::size(r)), ...);
+      } else if constexpr (std::is_base_of_v<std::random_access_iterator_tag, category>) {
+        (std::get<Is>(columns).reserve(distance(std::cbegin(r), std::cend(r))), ...);
+      }
+      for (auto const &x : r) (std::get<Is>(columns).emplace_back(std::get<Is>(x)), ...);
+      return columns;
+    }(std::make_index_sequence<std::tuple_size_v<value_t>>{});
   }
 
+  /**
+   * Zip the vectors returned by collect_soa, yielding tuples of references to the components.
+   *
+   * @param columns The tuple of vectors
+   */
+  template <typename... V> auto zip_soa(std::tuple<V...> &columns) {
+    return std::apply([](auto &...v) { return zip(v...); }, columns);
+  }
+
+  template <typename... V> auto zip_soa(std::tuple<V...> const &columns) {
+    return std::apply([](auto const &...v) { return zip(v...); }, columns);
+  }
+
+  /**
+   * Collect the elements of a range into a std::vector, see collect.
+   *
+   * @param r The range to collect
+   */
+  template <typename R> auto make_vector_from_range(R const &r) { return collect<std::vector>(r); }
+
   /********************* Functionality related to Integer ranges ********************/
 
   /**
@@ -590,7 +1395,7 @@ namespace itertools {
       long pos, last, step;
 
       using value_type        = long;
-      using iterator_category = std::forward_iterator_tag;
+      using iterator_category = std::random_access_iterator_tag;
       using pointer           = value_type *;
       using difference_type   = std::ptrdiff_t;
       using reference         = value_type const &;
@@ -606,35 +1411,319 @@ namespace itertools {
         return c;
       }
 
-      [[nodiscard]] bool atEnd() const noexcept { return step > 0 ? pos >= last : pos <= last; }
+      const_iterator &operator--() noexcept {
+        pos -= step;
+        return *this;
+      }
+
+      const_iterator operator--(int) noexcept {
+        const_iterator c = *this;
+        pos -= step;
+        return c;
+      }
+
+      const_iterator &operator+=(difference_type n) noexcept {
+        pos += n * step;
+        return *this;
+      }
 
-      bool operator==(const_iterator const &other) const noexcept {
-        // EXPECTS(other.last == this->last);
-        // EXPECTS(other.step == this->step);
-        return (other.pos == this->pos) || (other.atEnd() && this->atEnd());
+      const_iterator &operator-=(difference_type n) noexcept {
+        pos -= n * step;
+        return *this;
       }
-      bool operator!=(const_iterator const &other) const noexcept { return (!operator==(other)); }
+
+      friend const_iterator operator+(const_iterator it, difference_type n) noexcept { return it += n; }
+      friend const_iterator operator+(difference_type n, const_iterator it) noexcept { return it += n; }
+      friend const_iterator operator-(const_iterator it, difference_type n) noexcept { return it -= n; }
+
+      // EXPECTS(other.step == this->step);
+      friend difference_type operator-(const_iterator const &x, const_iterator const &y) noexcept { return (x.pos - y.pos) / x.step; }
+
+      [[nodiscard]] bool atEnd() const noexcept { return step > 0 ? pos >= last : pos <= last; }
+
+      // The end iterator of a range lies exactly on the progression, such that comparing positions is sufficient
+      bool operator==(const_iterator const &other) const noexcept { return other.pos == this->pos; }
+
+      std::strong_ordering operator<=>(const_iterator const &other) const noexcept { return (*this - other) <=> 0; }
 
       long operator*() const noexcept { return pos; }
       long operator->() const noexcept { return operator*(); }
+      long operator[](difference_type n) const noexcept { return pos + n * step; }
     };
 
     [[nodiscard]] const_iterator begin() const noexcept { return {first_, last_, step_}; }
     [[nodiscard]] const_iterator cbegin() const noexcept { return {first_, last_, step_}; }
 
-    [[nodiscard]] const_iterator end() const noexcept { return {last_, last_, step_}; }
-    [[nodiscard]] const_iterator cend() const noexcept { return {last_, last_, step_}; }
+    [[nodiscard]] const_iterator end() const noexcept { return {first_ + size() * step_, last_, step_}; }
+    [[nodiscard]] const_iterator cend() const noexcept { return end(); }
   };
 
+  /**
+   * Slice of an integer range.
+   * Since a range is an arithmetic progression, the slice is computed exactly as a range.
+   *
+   * @param r The range to slice
+   * @param start_idx The index to start the slice at
+   * @param end_idx The index one past the end of the sliced range
+   */
+  inline range slice(range const &r, std::ptrdiff_t start_idx, std::ptrdiff_t end_idx) {
+    std::ptrdiff_t n = r.size(), i = std::min(std::max(start_idx, std::ptrdiff_t{0}), n), j = std::min(std::max(end_idx, i), n);
+    return {r.first() + i * r.step(), r.first() + j * r.step(), r.step()};
+  }
+
+  /**
+   * Every stride-th index of an integer range, again computed exactly as a range.
+   *
+   * @param r The range to take the subrange of
+   * @param stride The number of elements to skip
+   */
+  inline range stride(range const &r, std::ptrdiff_t stride) {
+    if (stride <= 0) throw std::runtime_error("strided range requires a positive stride");
+    return {r.first(), r.first() + r.size() * r.step(), r.step() * stride};
+  }
+
+  /********************* Pipe syntax ********************/
+
+  namespace detail {
+
+    // Closures of the range adapting functions, applied to a range with operator|
+    template <typename L> struct transform_closure {
+      L lambda;
+    };
+    struct enumerate_closure {};
+    struct slice_closure {
+      std::ptrdiff_t start_idx, end_idx;
+    };
+    struct stride_closure {
+      std::ptrdiff_t stride;
+    };
+
+    template <typename T> struct is_transformed : std::false_type {};
+    template <typename T, typename L> struct is_transformed<transformed<T, L>> : std::true_type {};
+
+    template <typename T> struct is_sliced : std::false_type {};
+    template <typename T> struct is_sliced<sliced<T>> : std::true_type {};
+
+    template <typename T> struct is_strided : std::false_type {};
+    template <typename T> struct is_strided<strided<T>> : std::true_type {};
+
+    // An adapter can be fused with the next one if it can be moved from or is cheap to copy
+    template <typename R> constexpr bool can_fuse_v = not std::is_lvalue_reference_v<R> or std::ranges::view<std::remove_cvref_t<R>>;
+
+    // The composition g(f(x)) of two functions, calling the non-const operator() as transform_iter does
+    template <typename F, typename G> struct composed {
+      F f;
+      G g;
+      template <typename X> decltype(auto) operator()(X &&x) { return g(f(std::forward<X>(x))); }
+    };
+
+    template <typename T, typename L1, typename L2> transformed<T, composed<L1, L2>> fuse_transform(transformed<T, L1> &&t, L2 lambda) {
+      return {std::move(t.x), {std::move(t.lambda), std::move(lambda)}};
+    }
+    template <typename T, typename L1, typename L2> transformed<T, composed<L1, L2>> fuse_transform(transformed<T, L1> const &t, L2 lambda) {
+      return {t.x, {t.lambda, std::move(lambda)}};
+    }
+
+    /*
+     * Apply the adapters to a range. Consecutive adapters are fused where possible:
+     *
+     *   - transform of transform composes the lambdas
+     *   - slice of slice and stride of stride combine the indices and strides
+     *   - slice and stride of a range yield a range
+     *
+     * Slice and stride do not wrap the iterator of a slice, such that their combination iterates
+     * with a single stride_iter over the underlying iterator.
+     */
+    template <typename R, typename L> auto operator|(R &&r, transform_closure<L> c) {
+      using R_t = std::remove_cvref_t<R>;
+      if constexpr (is_transformed<R_t>::value and can_fuse_v<R>) {
+        return fuse_transform(std::forward<R>(r), std::move(c.lambda));
+      } else {
+        return transform(std::forward<R>(r), std::move(c.lambda));
+      }
+    }
+
+    template <typename R> auto operator|(R &&r, enumerate_closure) { return enumerate(std::forward<R>(r)); }
+
+    template <typename R> auto operator|(R &&r, slice_closure c) {
+      using R_t = std::remove_cvref_t<R>;
+      if constexpr (is_sliced<R_t>::value and can_fuse_v<R>) {
+        auto n = r.size();
+        auto i = std::min(std::max(c.start_idx, std::ptrdiff_t{0}), n), j = std::min(std::max(c.end_idx, i), n);
+        return R_t{std::forward<R>(r).x, r.start_idx + i, r.start_idx + j};
+      } else {
+        return slice(std::forward<R>(r), c.start_idx, c.end_idx);
+      }
+    }
+
+    template <typename R> auto operator|(R &&r, stride_closure c) {
+      using R_t = std::remove_cvref_t<R>;
+      if constexpr (is_strided<R_t>::value and can_fuse_v<R>) {
+        return R_t{std::forward<R>(r).x, r.stride * c.stride};
+      } else {
+        return stride(std::forward<R>(r), c.stride);
+      }
+    }
+
+  } // namespace detail
+
+  /**
+   * Closure of transform for the pipe syntax: r | transform(lambda) is transform(r, lambda).
+   *
+   * @example
+   *
+   *      for (auto x : zip(a, b) | stride(2) | slice(0, n) | transform(f)) { ... }
+   */
+  template <typename L> detail::transform_closure<L> transform(L lambda) { return {std::move(lambda)}; }
+
+  /// Closure of enumerate for the pipe syntax: r | enumerate() is enumerate(r)
+  inline detail::enumerate_closure enumerate() { return {}; }
+
+  /// Closure of slice for the pipe syntax: r | slice(start_idx, end_idx) is slice(r, start_idx, end_idx)
+  inline detail::slice_closure slice(std::ptrdiff_t start_idx, std::ptrdiff_t end_idx) { return {start_idx, end_idx}; }
+
+  /// Closure of stride for the pipe syntax: r | stride(s) is stride(r, s)
+  inline detail::stride_closure stride(std::ptrdiff_t stride) { return {stride}; }
+
+  namespace detail {
+
+    /********************* Product Range Iterator ********************/
+
+    // std::tuple<long, ..., long> with Rank elements
+    template <size_t Rank> using long_tuple_t = decltype(std::tuple_cat(std::declval<std::array<long, Rank>>()));
+
+    // Extents of a product_range known at compile-time
+    template <long... Ns> struct static_extents {
+      static constexpr std::array<long, sizeof...(Ns)> values = {Ns...};
+      constexpr long operator[](size_t n) const noexcept { return values[n]; }
+      bool operator==(static_extents const &) const = default;
+    };
+
+    /*
+     * Iterator over the product of the integer ranges [0, ext[0]) x ... x [0, ext[Rank - 1)
+     * in row-major order (rightmost index fastest).
+     *
+     * It holds the linear position in the product, which alone determines equality and distances,
+     * together with the current index vector, which is updated by carry propagation.
+     *
+     * @tparam Extents std::array<long, Rank> or static_extents<Ns...>
+     */
+    template <size_t Rank, typename Extents = std::array<long, Rank>>
+    struct prod_range_iter
+       : iterator_facade<prod_range_iter<Rank, Extents>, long_tuple_t<Rank>, std::random_access_iterator_tag, long_tuple_t<Rank>> {
+
+      [[no_unique_address]] Extents ext = {};
+      std::array<long, Rank> idx        = {};
+      long pos                          = 0;
+
+      constexpr prod_range_iter() = default;
+      constexpr prod_range_iter(Extents ext, long pos) : ext(ext), pos(pos) { set_index(); }
+
+      private:
+      template <int N> [[gnu::always_inline]] constexpr void _increment() {
+        if constexpr (N > 0) {
+          if (++idx[N] == ext[N]) {
+            idx[N] = 0;
+            _increment<N - 1>();
+          }
+        } else {
+          ++idx[0];
+        }
+      }
+
+      template <int N> [[gnu::always_inline]] constexpr void _decrement() {
+        if constexpr (N > 0) {
+          if (idx[N] == 0) {
+            idx[N] = ext[N];
+            _decrement<N - 1>();
+          }
+        }
+        --idx[N];
+      }
+
+      // Decode the linear position into the index vector by mixed-radix division
+      constexpr void set_index() {
+        long p = pos;
+        for (int n = Rank - 1; n > 0; --n) {
+          if (ext[n] == 0) return;
+          idx[n] = p % ext[n];
+          p /= ext[n];
+        }
+        idx[0] = p;
+      }
+
+      public:
+      constexpr void increment() {
+        ++pos;
+        _increment<Rank - 1>();
+      }
+
+      constexpr void decrement() {
+        --pos;
+        _decrement<Rank - 1>();
+      }
+
+      constexpr void advance(std::ptrdiff_t n) {
+        pos += n;
+        set_index();
+      }
+
+      [[nodiscard]] constexpr std::ptrdiff_t distance_to(prod_range_iter const &other) const { return other.pos - pos; }
+
+      [[nodiscard]] constexpr std::ptrdiff_t distance_to(sentinel_t<long> const &s) const { return s.it - pos; }
+
+      constexpr bool operator==(prod_range_iter const &other) const { return pos == other.pos; }
+
+      constexpr bool operator==(sentinel_t<long> const &s) const { return pos == s.it; }
+
+      [[nodiscard]] constexpr long_tuple_t<Rank> dereference() const {
+        return [this]<size_t... Is>(std::index_sequence<Is...>) { return long_tuple_t<Rank>{idx[Is]...}; }(std::make_index_sequence<Rank>{});
+      }
+    };
+
+    // ---------------------------------------------
+
+    template <size_t Rank, typename Extents = std::array<long, Rank>> struct multiplied_range {
+      [[no_unique_address]] Extents ext;
+
+      using iterator       = prod_range_iter<Rank, Extents>;
+      using const_iterator = iterator;
+
+      bool operator==(multiplied_range const &) const = default;
+
+      /// Extents of the individual integer ranges
+      [[nodiscard]] constexpr std::array<long, Rank> extents() const noexcept {
+        return [this]<size_t... Is>(std::index_sequence<Is...>) { return std::array<long, Rank>{ext[Is]...}; }(std::make_index_sequence<Rank>{});
+      }
+
+      /// Number of index tuples in the product
+      [[nodiscard]] constexpr long size() const noexcept {
+        long res = 1;
+        for (size_t n = 0; n < Rank; ++n) res *= ext[n];
+        return res;
+      }
+
+      [[nodiscard]] constexpr const_iterator cbegin() const noexcept { return {ext, 0}; }
+      [[nodiscard]] constexpr const_iterator begin() const noexcept { return cbegin(); }
+
+      [[nodiscard]] constexpr auto cend() const noexcept { return make_sentinel(size()); }
+      [[nodiscard]] constexpr auto end() const noexcept { return cend(); }
+    };
+
+  } // namespace detail
+
   /**
    * A product of an arbitrary number of integer ranges
    * given a set of integers or an integer tuple
    *
+   * Equivalent to product(range(Is)...), but iterates with a single linear counter.
+   * Negative extents are treated as empty ranges.
+   *
    * @tparam Integers The integer types
    */
   template <typename... Integers, typename EnableIf = std::enable_if_t<(std::is_integral_v<Integers> and ...), int>>
-  auto product_range(Integers... Is) {
-    return product(range(Is)...);
+  detail::multiplied_range<sizeof...(Integers)> product_range(Integers... Is) {
+    return {std::array<long, sizeof...(Integers)>{std::max(long(Is), 0l)...}};
   }
 
   namespace detail {
@@ -653,6 +1742,179 @@ namespace itertools {
     return detail::product_range_impl(idx_arr, std::make_index_sequence<Rank>{});
   }
 
+  /**
+   * A product of integer ranges with extents known at compile-time
+   *
+   * The extents are part of the type, such that the carry logic of the
+   * iteration is fully known to the compiler, e.g.
+   *
+   *      for (auto [i, j, k] : product_range<2, 3, 5>()) { ... }
+   *
+   * @tparam Ns The extents of the ranges
+   */
+  template <long... Ns>
+     requires(sizeof...(Ns) > 0 and ((Ns >= 0) and ...))
+  constexpr detail::multiplied_range<sizeof...(Ns), detail::static_extents<Ns...>> product_range() {
+    return {};
+  }
+
+  /**
+   * A product of integer ranges with extents given as std::integral_constant
+   *
+   * Equivalent to product_range<Ns...>()
+   */
+  template <typename... Integers, Integers... Ns> constexpr auto product_range(std::integral_constant<Integers, Ns>...) {
+    return product_range<long(Ns)...>();
+  }
+
+  namespace detail {
+
+    /********************* Tiled Product Iterator ********************/
+
+    /*
+     * Iterator over the product of random-access ranges, visiting the index space tile by tile.
+     *
+     * The tiles are visited in row-major order, and so are the elements within each tile.
+     * Tiles at the upper boundaries are truncated to the extents of the ranges.
+     *
+     * @tparam TileSizes std::array<long, Rank> or static_extents<Ts...>
+     */
+    template <typename TileSizes, typename... It>
+    struct tiled_prod_iter : iterator_facade<tiled_prod_iter<TileSizes, It...>, std::tuple<typename std::iterator_traits<It>::value_type...>> {
+
+      static constexpr long Rank = sizeof...(It);
+
+      std::tuple<It...> its_begin;
+      std::array<long, Rank> ext = {};
+      [[no_unique_address]] TileSizes tile = {};
+      std::array<long, Rank> tile_start = {}, tile_end = {}, idx = {};
+      long pos = 0;
+
+      tiled_prod_iter() = default;
+      tiled_prod_iter(std::tuple<It...> its_begin, std::array<long, Rank> ext, TileSizes tile)
+         : its_begin(std::move(its_begin)), ext(ext), tile(tile) {
+        for (long n = 0; n < Rank; ++n) tile_end[n] = std::min(tile[n], ext[n]);
+      }
+
+      private:
+      // Increment the index within the current tile, returns false if the tile is exhausted
+      template <int N> [[gnu::always_inline]] bool _increment_in_tile() {
+        if (++idx[N] < tile_end[N]) return true;
+        idx[N] = tile_start[N];
+        if constexpr (N > 0)
+          return _increment_in_tile<N - 1>();
+        else
+          return false;
+      }
+
+      template <int N> void _next_tile() {
+        tile_start[N] += tile[N];
+        if constexpr (N > 0) {
+          if (tile_start[N] >= ext[N]) {
+            tile_start[N] = 0;
+            _next_tile<N - 1>();
+          }
+        }
+        tile_end[N] = std::min(tile_start[N] + tile[N], ext[N]);
+      }
+
+      template <size_t... Is> [[gnu::always_inline]] [[nodiscard]] auto tuple_map_impl(std::index_sequence<Is...>) const {
+        return std::tuple<decltype(*std::get<Is>(its_begin))...>(*(std::get<Is>(its_begin) + idx[Is])...);
+      }
+
+      public:
+      void increment() {
+        ++pos;
+        if (_increment_in_tile<Rank - 1>()) return;
+        _next_tile<Rank - 1>();
+        idx = tile_start;
+      }
+
+      bool operator==(tiled_prod_iter const &other) const { return pos == other.pos; }
+
+      bool operator==(sentinel_t<long> const &s) const { return pos == s.it; }
+
+      [[nodiscard]] decltype(auto) dereference() const { return tuple_map_impl(std::index_sequence_for<It...>{}); }
+    };
+
+    // ---------------------------------------------
+
+    template <typename TileSizes, typename... T> struct tiled {
+      std::tuple<stored_t<T>...> tu;
+      [[no_unique_address]] TileSizes tile;
+
+      using iterator       = tiled_prod_iter<TileSizes, decltype(std::begin(std::declval<T &>()))...>;
+      using const_iterator = tiled_prod_iter<TileSizes, decltype(std::cbegin(std::declval<T &>()))...>;
+
+      template <typename... U> tiled(TileSizes tile, U &&...ranges) : tu{std::forward<U>(ranges)...}, tile(tile) {
+        for (size_t n = 0; n < sizeof...(T); ++n)
+          if (tile[n] <= 0) throw std::runtime_error("tiled_product requires positive tile sizes");
+      }
+
+      private:
+      [[nodiscard]] std::array<long, sizeof...(T)> extents() const {
+        return std::apply([](auto const &...x) { return std::array<long, sizeof...(T)>{long(itertools::distance(std::cbegin(x), std::cend(x)))...}; },
+                          tu);
+      }
+
+      public:
+      /// Number of elements in the product
+      [[nodiscard]] long size() const {
+        long res = 1;
+        for (auto e : extents()) res *= e;
+        return res;
+      }
+
+      [[nodiscard]] iterator begin() noexcept {
+        return {std::apply([](auto &...x) { return std::make_tuple(std::begin(x)...); }, tu), extents(), tile};
+      }
+      [[nodiscard]] const_iterator cbegin() const noexcept {
+        return {std::apply([](auto const &...x) { return std::make_tuple(std::cbegin(x)...); }, tu), extents(), tile};
+      }
+      [[nodiscard]] const_iterator begin() const noexcept { return cbegin(); }
+
+      [[nodiscard]] auto cend() const noexcept { return make_sentinel(size()); }
+      [[nodiscard]] auto end() const noexcept { return cend(); }
+    };
+
+  } // namespace detail
+
+  /**
+   * Lazy-product of random-access ranges, visited tile by tile (cache blocking).
+   *
+   * Yields the same tuples as product(ranges...), but in a different order: The index space is
+   * divided into tiles of the given sizes, which are visited in row-major order, and the elements
+   * of each tile are visited in row-major order. This improves the locality of e.g. transposes or
+   * stencils that access an array along several directions.
+   *
+   * @param tile_sizes The tile size for each range
+   * @param ranges The ranges to multiply
+   *
+   * @example
+   *
+   *      for (auto [i, j] : tiled_product(std::array{32l, 32l}, range(N), range(N))) B(j, i) = A(i, j);
+   */
+  template <typename... T>
+  detail::tiled<std::array<long, sizeof...(T)>, T...> tiled_product(std::array<long, sizeof...(T)> tile_sizes, T &&...ranges) {
+    return {tile_sizes, std::forward<T>(ranges)...};
+  }
+
+  /**
+   * Lazy-product of random-access ranges, visited tile by tile with tile sizes known at compile-time.
+   *
+   * @tparam Ts The tile size for each range
+   * @param ranges The ranges to multiply
+   *
+   * @example
+   *
+   *      for (auto [i, j] : tiled_product<32, 32>(range(N), range(N))) B(j, i) = A(i, j);
+   */
+  template <long... Ts, typename... T>
+     requires(sizeof...(Ts) == sizeof...(T) and ((Ts > 0) and ...))
+  detail::tiled<detail::static_extents<Ts...>, T...> tiled_product(T &&...ranges) {
+    return {detail::static_extents<Ts...>{}, std::forward<T>(ranges)...};
+  }
+
   /**
    * Given an integer range [start, end), chunk it as equally as possible into n_chunks.
    * If the range is not dividable in n_chunks equal parts, the first chunks have
@@ -668,6 +1930,79 @@ namespace itertools {
       return {start + n_large_nodes + rank * chunk_size, start + n_large_nodes + (rank + 1) * chunk_size};
   }
 
+  /**
+   * The cost of processing each position [0, n) of a range, stored as prefix sums.
+   *
+   * It allows to chunk a range such that all chunks have about the same total cost
+   * with weighted_chunk_range. The prefix sums are computed once on construction and can
+   * be reused for repeated sweeps over the same range.
+   */
+  class cost_model {
+    std::vector<double> prefix_sums_ = {0.0};
+
+    public:
+    /**
+     * Construct from a cost function
+     *
+     * @param n The number of positions
+     * @param cost The cost of position i is given by cost(i)
+     */
+    template <typename F, typename EnableIf = std::enable_if_t<std::is_invocable_v<F, long>, int>> cost_model(long n, F &&cost) {
+      prefix_sums_.reserve(n + 1);
+      for (long i = 0; i < n; ++i) prefix_sums_.push_back(prefix_sums_.back() + double(cost(i)));
+    }
+
+    /**
+     * Construct from precomputed prefix sums
+     *
+     * @param prefix_sums Non-decreasing sums of the costs of the first i positions for i = 0, ..., n
+     */
+    explicit cost_model(std::vector<double> prefix_sums) : prefix_sums_(std::move(prefix_sums)) {
+      if (prefix_sums_.empty() or prefix_sums_[0] != 0.0) throw std::runtime_error("cost_model requires prefix sums starting with 0");
+    }
+
+    /// Number of positions
+    [[nodiscard]] long size() const { return long(prefix_sums_.size()) - 1; }
+
+    /// Total cost of all positions
+    [[nodiscard]] double total() const { return prefix_sums_.back(); }
+
+    /// The prefix sums of the costs
+    [[nodiscard]] std::vector<double> const &prefix_sums() const { return prefix_sums_; }
+
+    /// Position at which the accumulated cost is closest to the fraction rank / n_chunks of the total cost
+    [[nodiscard]] std::ptrdiff_t boundary(long n_chunks, long rank) const {
+      if (rank <= 0) return 0;
+      if (rank >= n_chunks) return size();
+      double target = total() * double(rank) / double(n_chunks);
+      auto it       = std::lower_bound(prefix_sums_.begin(), prefix_sums_.end(), target);
+      if (it == prefix_sums_.end()) return size();
+      if (it != prefix_sums_.begin() and target - *std::prev(it) < *it - target) --it;
+      return it - prefix_sums_.begin();
+    }
+  };
+
+  /**
+   * Given the costs of the positions [0, n) of a range, chunk it into n_chunks consecutive
+   * parts with about equal total cost, by binary search in the prefix sums.
+   * Returns the positions [start, end) of the chunk with the given rank.
+   */
+  inline std::pair<std::ptrdiff_t, std::ptrdiff_t> weighted_chunk_range(cost_model const &costs, long n_chunks, long rank) {
+    return {costs.boundary(n_chunks, rank), costs.boundary(n_chunks, rank + 1)};
+  }
+
+  /**
+   * Given an integer range [start, end) and the cost of each index i given by cost(i),
+   * chunk it into n_chunks consecutive parts with about equal total cost.
+   *
+   * The prefix sums are computed on every call. For repeated sweeps construct a cost_model once instead.
+   */
+  template <typename F>
+  std::pair<std::ptrdiff_t, std::ptrdiff_t> weighted_chunk_range(std::ptrdiff_t start, std::ptrdiff_t end, F &&cost, long n_chunks, long rank) {
+    auto [first, last] = weighted_chunk_range(cost_model(end - start, [&](long i) { return cost(start + i); }), n_chunks, rank);
+    return {start + first, start + last};
+  }
+
   /**
    * Apply a function f to every element of an integer range
    *
@@ -684,4 +2019,70 @@ namespace itertools {
 
 } // namespace itertools
 
+/********************* Integration with C++20 ranges ********************/
+
+// zip_ref is a tuple, and has a common reference with the value type and the rvalue reference of the zip iterators.
+namespace std {
+
+  template <typename... R> struct tuple_size<itertools::detail::zip_ref<R...>> : integral_constant<size_t, sizeof...(R)> {};
+  template <size_t I, typename... R> struct tuple_element<I, itertools::detail::zip_ref<R...>> : tuple_element<I, tuple<R...>> {};
+
+  template <typename... A, typename... B, template <typename> class AQ, template <typename> class BQ>
+    requires(sizeof...(A) == sizeof...(B))
+  struct basic_common_reference<itertools::detail::zip_ref<A...>, itertools::detail::zip_ref<B...>, AQ, BQ> {
+    using type = itertools::detail::zip_ref<common_reference_t<AQ<A>, BQ<B>>...>;
+  };
+
+  template <typename... A, typename... B, template <typename> class AQ, template <typename> class BQ>
+    requires(sizeof...(A) == sizeof...(B))
+  struct basic_common_reference<itertools::detail::zip_ref<A...>, tuple<B...>, AQ, BQ> {
+    using type = itertools::detail::zip_ref<common_reference_t<AQ<A>, BQ<B>>...>;
+  };
+
+  template <typename... A, typename... B, template <typename> class AQ, template <typename> class BQ>
+    requires(sizeof...(A) == sizeof...(B))
+  struct basic_common_reference<tuple<A...>, itertools::detail::zip_ref<B...>, AQ, BQ> {
+    using type = itertools::detail::zip_ref<common_reference_t<AQ<A>, BQ<B>>...>;
+  };
+
+} // namespace std
+
+// The adapters model std::ranges::view if they hold only references and views, and std::ranges::borrowed_range
+// if they hold only references and borrowed ranges, i.e. if their iterators remain valid after the adapter is destroyed.
+namespace std::ranges {
+
+  template <> inline constexpr bool enable_view<itertools::range>            = true;
+  template <> inline constexpr bool enable_borrowed_range<itertools::range> = true;
+
+  template <size_t Rank, typename Extents> inline constexpr bool enable_view<itertools::detail::multiplied_range<Rank, Extents>>            = true;
+  template <size_t Rank, typename Extents> inline constexpr bool enable_borrowed_range<itertools::detail::multiplied_range<Rank, Extents>> = true;
+
+  template <typename T, typename L> inline constexpr bool enable_view<itertools::detail::transformed<T, L>> = itertools::detail::is_view_v<T>;
+  template <typename T, typename L>
+  inline constexpr bool enable_borrowed_range<itertools::detail::transformed<T, L>> = itertools::detail::is_borrowed_v<T>;
+
+  template <typename T> inline constexpr bool enable_view<itertools::detail::enumerated<T>>            = itertools::detail::is_view_v<T>;
+  template <typename T> inline constexpr bool enable_borrowed_range<itertools::detail::enumerated<T>> = itertools::detail::is_borrowed_v<T>;
+
+  template <typename T> inline constexpr bool enable_view<itertools::detail::sliced<T>>            = itertools::detail::is_view_v<T>;
+  template <typename T> inline constexpr bool enable_borrowed_range<itertools::detail::sliced<T>> = itertools::detail::is_borrowed_v<T>;
+
+  template <typename T> inline constexpr bool enable_view<itertools::detail::strided<T>>            = itertools::detail::is_view_v<T>;
+  template <typename T> inline constexpr bool enable_borrowed_range<itertools::detail::strided<T>> = itertools::detail::is_borrowed_v<T>;
+
+  template <typename... T> inline constexpr bool enable_view<itertools::detail::zipped<T...>> = (itertools::detail::is_view_v<T> and ...);
+  template <typename... T>
+  inline constexpr bool enable_borrowed_range<itertools::detail::zipped<T...>> = (itertools::detail::is_borrowed_v<T> and ...);
+
+  template <typename... T> inline constexpr bool enable_view<itertools::detail::multiplied<T...>> = (itertools::detail::is_view_v<T> and ...);
+  template <typename... T>
+  inline constexpr bool enable_borrowed_range<itertools::detail::multiplied<T...>> = (itertools::detail::is_borrowed_v<T> and ...);
+
+  template <typename TileSizes, typename... T>
+  inline constexpr bool enable_view<itertools::detail::tiled<TileSizes, T...>> = (itertools::detail::is_view_v<T> and ...);
+  template <typename TileSizes, typename... T>
+  inline constexpr bool enable_borrowed_range<itertools::detail::tiled<TileSizes, T...>> = (itertools::detail::is_borrowed_v<T> and ...);
+
+} // namespace std::ranges
+
 #endif
@@ -0,0 +1,91 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <mpi.h>
+
+#include <itertools/itertools.hpp>
+#include <itertools/omp_chunk.hpp>
+
+#include <array>
+#include <memory>
+
+namespace itertools {
+
+  /**
+    * Function to chunk a range, distributing it uniformly over all MPI ranks of a communicator.
+    *
+    * Rank r obtains the r-th chunk of chunk_range. Any range that can be sliced can be used,
+    * e.g. range, product_range or zip. For random-access ranges the chunk is obtained in O(1).
+    * Ranges providing a member chunk(n_chunks, rank), e.g. morton_product_range, are split by it.
+    *
+    * @tparam T The type of the range
+    *
+    * @param range The range to chunk
+    * @param comm The MPI communicator
+    */
+  template <typename T> auto mpi_chunk(T &&range, MPI_Comm comm = MPI_COMM_WORLD) {
+    int n_ranks = 1, rank = 0;
+    MPI_Comm_size(comm, &n_ranks);
+    MPI_Comm_rank(comm, &rank);
+    if constexpr (requires { range.chunk(1l, 0l); }) {
+      return range.chunk(n_ranks, rank);
+    } else {
+      auto total_size           = itertools::distance(std::cbegin(range), std::cend(range));
+      auto [start_idx, end_idx] = chunk_range(0, total_size, n_ranks, rank);
+      return itertools::slice(std::forward<T>(range), start_idx, end_idx);
+    }
+  }
+
+  /**
+    * Function to chunk a range in two levels, first uniformly over all MPI ranks of a communicator
+    * and then uniformly over all OMP threads of each rank.
+    *
+    * This range-adapting function should be used inside an omp parallel region, and be reached by all
+    * threads of the team. The communicator is queried by the primary thread only, such that MPI should
+    * be initialized with at least MPI_THREAD_FUNNELED and the region should be opened by the main thread.
+    *
+    * @tparam T The type of the range
+    *
+    * @param range The range to chunk
+    * @param comm The MPI communicator
+    *
+    * @example
+    *
+    *      #pragma omp parallel
+    *      for (auto [i, j, k] : mpi_omp_chunk(product_range(N, N, N))) { ... }
+    */
+  template <typename T> auto mpi_omp_chunk(T &&range, MPI_Comm comm = MPI_COMM_WORLD) {
+    // Team-local storage, allocated by any thread and filled by the primary thread
+    std::shared_ptr<std::array<int, 2>> layout;
+#pragma omp single copyprivate(layout)
+    layout = std::make_shared<std::array<int, 2>>(std::array{1, 0});
+    if (omp_get_thread_num() == 0) {
+      MPI_Comm_size(comm, &(*layout)[0]);
+      MPI_Comm_rank(comm, &(*layout)[1]);
+    }
+#pragma omp barrier
+    auto [n_ranks, rank] = *layout;
+    if constexpr (requires { range.chunk(1l, 0l); }) {
+      return range.chunk(n_ranks, rank).chunk(omp_get_num_threads(), omp_get_thread_num());
+    } else {
+      auto total_size                 = itertools::distance(std::cbegin(range), std::cend(range));
+      auto [rank_start, rank_end]     = chunk_range(0, total_size, n_ranks, rank);
+      auto [thread_start, thread_end] = chunk_range(rank_start, rank_end, omp_get_num_threads(), omp_get_thread_num());
+      return itertools::slice(std::forward<T>(range), thread_start, thread_end);
+    }
+  }
+
+} // namespace itertools
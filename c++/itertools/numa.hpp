@@ -0,0 +1,188 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <omp.h>
+
+#include <itertools/itertools.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace itertools {
+
+  namespace detail {
+
+    // Parse a Linux cpu list such as "0-3,8,10-11" into the list of cpus
+    inline std::vector<int> parse_cpu_list(std::string const &str) {
+      std::vector<int> cpus;
+      std::stringstream ss(str);
+      std::string item;
+      while (std::getline(ss, item, ',')) {
+        if (item.find_first_of("0123456789") == std::string::npos) continue;
+        auto dash = item.find('-');
+        int first = std::stoi(item.substr(0, dash));
+        int last  = (dash == std::string::npos) ? first : std::stoi(item.substr(dash + 1));
+        for (int c = first; c <= last; ++c) cpus.push_back(c);
+      }
+      return cpus;
+    }
+
+  } // namespace detail
+
+  /**
+   * The NUMA topology of the machine, i.e. the NUMA node of every cpu.
+   *
+   * On Linux it is read from /sys/devices/system/node. Otherwise, or if this information
+   * is not available, all cpus are assumed to belong to node 0.
+   */
+  class numa_topology {
+    std::vector<int> cpu_to_node_;
+    int n_nodes_ = 1;
+
+    public:
+    numa_topology() {
+#ifdef __linux__
+      std::string const dir = "/sys/devices/system/node/";
+      std::ifstream online(dir + "online");
+      std::string line;
+      if (!std::getline(online, line)) return;
+      for (int node : detail::parse_cpu_list(line)) {
+        std::ifstream f(dir + "node" + std::to_string(node) + "/cpulist");
+        if (!std::getline(f, line)) continue;
+        for (int cpu : detail::parse_cpu_list(line)) {
+          if (cpu >= long(cpu_to_node_.size())) cpu_to_node_.resize(cpu + 1, 0);
+          cpu_to_node_[cpu] = node;
+        }
+        n_nodes_ = std::max(n_nodes_, node + 1);
+      }
+#endif
+    }
+
+    /// The topology of the current machine, read once
+    static numa_topology const &get() {
+      static numa_topology const topo;
+      return topo;
+    }
+
+    /// Number of NUMA nodes
+    [[nodiscard]] int n_nodes() const { return n_nodes_; }
+
+    /// The NUMA node of a given cpu
+    [[nodiscard]] int node_of_cpu(int cpu) const { return (cpu >= 0 and cpu < long(cpu_to_node_.size())) ? cpu_to_node_[cpu] : 0; }
+  };
+
+  /**
+   * The cpus the calling thread is bound to, as reported by sched_getaffinity.
+   * Empty if this information is not available.
+   */
+  inline std::vector<int> bound_cpus() {
+    std::vector<int> cpus;
+#ifdef __linux__
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0)
+      for (int c = 0; c < CPU_SETSIZE; ++c)
+        if (CPU_ISSET(c, &mask)) cpus.push_back(c);
+#endif
+    return cpus;
+  }
+
+  /**
+   * The NUMA node of the calling thread, i.e. the node of the first cpu it is bound to.
+   *
+   * This is only meaningful if the threads are pinned, e.g. with OMP_PROC_BIND=true
+   * or OMP_PLACES=cores, and otherwise yields the same node for all threads.
+   */
+  inline int current_numa_node() {
+    auto cpus = bound_cpus();
+    return cpus.empty() ? 0 : numa_topology::get().node_of_cpu(cpus[0]);
+  }
+
+  /**
+    * Given an integer range [start, end), chunk it over all OMP threads such that
+    * threads on the same NUMA node obtain neighbouring chunks.
+    *
+    * The chunks are those of chunk_range, but they are assigned to the threads ordered by
+    * their NUMA node and, within a node, by their thread number. With pinned threads the
+    * assignment is the same in every parallel region, such that data initialized
+    * (first-touched) with this split is later accessed from the same NUMA node.
+    *
+    * This function should be called by all threads inside an omp parallel region.
+    */
+  inline std::pair<std::ptrdiff_t, std::ptrdiff_t> omp_numa_chunk_range(std::ptrdiff_t start, std::ptrdiff_t end) {
+    std::shared_ptr<std::vector<int>> nodes;
+#pragma omp single copyprivate(nodes)
+    nodes = std::make_shared<std::vector<int>>(omp_get_num_threads());
+
+    int tid       = omp_get_thread_num();
+    (*nodes)[tid] = current_numa_node();
+#pragma omp barrier
+
+    // Rank of the thread when ordered by (node, thread number)
+    long n_threads = nodes->size(), rank = 0;
+    for (int t = 0; t < n_threads; ++t)
+      if (std::make_pair((*nodes)[t], t) < std::make_pair((*nodes)[tid], tid)) ++rank;
+    return chunk_range(start, end, n_threads, rank);
+  }
+
+  /**
+    * Function to chunk a range over all OMP threads, keeping the chunks of threads
+    * on the same NUMA node contiguous. See omp_numa_chunk_range.
+    *
+    * This range-adapting function should be called by all threads inside an omp parallel region.
+    *
+    * @tparam T The type of the range
+    *
+    * @param range The range to chunk
+    */
+  template <typename T> auto omp_numa_chunk(T &&range) {
+    auto total_size           = itertools::distance(std::cbegin(range), std::cend(range));
+    auto [start_idx, end_idx] = omp_numa_chunk_range(0, total_size);
+    return itertools::slice(std::forward<T>(range), start_idx, end_idx);
+  }
+
+  /**
+    * Initialize a buffer in parallel with the split of omp_numa_chunk.
+    *
+    * Every thread constructs the elements of its own chunk, such that the memory pages are placed
+    * on the NUMA node of the thread that will later process them with omp_numa_chunk.
+    * For this to take effect the memory must not have been touched before, e.g. by allocating it
+    * with std::make_unique_for_overwrite<T[]>(n) or std::malloc.
+    *
+    * This function opens its own parallel region.
+    *
+    * @param buffer The uninitialized storage
+    * @param value The value to initialize all elements with
+    */
+  template <typename T> void omp_numa_first_touch(std::span<T> buffer, T const &value = T{}) {
+    static_assert(std::is_trivially_destructible_v<T>, "omp_numa_first_touch requires a trivially destructible type");
+#pragma omp parallel
+    {
+      auto [start_idx, end_idx] = omp_numa_chunk_range(0, long(buffer.size()));
+      std::uninitialized_fill(buffer.begin() + start_idx, buffer.begin() + end_idx, value);
+    }
+  }
+
+} // namespace itertools
@@ -20,20 +20,148 @@
 
 #include <itertools/itertools.hpp>
 
+#include <atomic>
+#include <memory>
+
 namespace itertools {
 
   /**
     * Function to chunk a range, distributing it uniformly over all OMP threads.
     *
-    * This range-adapting function should be used inside an omp parallel region
+    * This range-adapting function should be used inside an omp parallel region.
+    * Ranges providing a member chunk(n_chunks, rank), e.g. morton_product_range, are split by it.
     *
     * @tparam T The type of the range
     *
     * @param range The range to chunk
     */
   template <typename T> auto omp_chunk(T &&range) {
-    auto total_size           = itertools::distance(std::cbegin(range), std::cend(range));
-    auto [start_idx, end_idx] = chunk_range(0, total_size, omp_get_num_threads(), omp_get_thread_num());
+    if constexpr (requires { range.chunk(1l, 0l); }) {
+      return range.chunk(omp_get_num_threads(), omp_get_thread_num());
+    } else {
+      auto total_size           = itertools::distance(std::cbegin(range), std::cend(range));
+      auto [start_idx, end_idx] = chunk_range(0, total_size, omp_get_num_threads(), omp_get_thread_num());
+      return itertools::slice(std::forward<T>(range), start_idx, end_idx);
+    }
+  }
+
+  /**
+    * Function to chunk a range over all OMP threads, such that all threads obtain
+    * about the same total cost according to a cost model.
+    *
+    * This range-adapting function should be used inside an omp parallel region.
+    * The cost model can be constructed once outside of the parallel region and reused.
+    *
+    * @tparam T The type of the range
+    *
+    * @param range The range to chunk
+    * @param costs The cost of every position of the range
+    */
+  template <typename T> auto omp_chunk(T &&range, cost_model const &costs) {
+    auto total_size = itertools::distance(std::cbegin(range), std::cend(range));
+    if (total_size != costs.size()) throw std::runtime_error("omp_chunk: the size of the cost model does not match the size of the range");
+    auto [start_idx, end_idx] = weighted_chunk_range(costs, omp_get_num_threads(), omp_get_thread_num());
     return itertools::slice(std::forward<T>(range), start_idx, end_idx);
   }
+
+  namespace detail {
+
+    // State shared by all threads iterating over the same omp_dynamic_chunks
+    struct dynamic_chunk_state {
+      std::atomic<long> next = 0;
+      long size, grain, n_threads;
+
+      dynamic_chunk_state(long size, long grain, long n_threads) : size(size), grain(grain), n_threads(n_threads) {}
+
+      // Claim the next block [first, last) of indices, or return an empty block at the end
+      std::pair<long, long> claim() {
+        long first = next.load(std::memory_order_relaxed);
+        long chunk = 0;
+        do {
+          long remaining = size - first;
+          if (remaining <= 0) return {size, size};
+          chunk = std::min(remaining, std::max(grain, remaining / (2 * n_threads)));
+        } while (!next.compare_exchange_weak(first, first + chunk, std::memory_order_relaxed));
+        return {first, first + chunk};
+      }
+    };
+
+    /********************* Dynamic Chunk Iterator ********************/
+
+    template <typename Iter>
+    struct dynamic_chunk_iter : iterator_facade<dynamic_chunk_iter<Iter>, typename std::iterator_traits<Iter>::value_type> {
+
+      Iter first, it;
+      dynamic_chunk_state *state = nullptr;
+      long pos = 0, block_end = 0;
+
+      dynamic_chunk_iter() = default;
+      dynamic_chunk_iter(Iter first, dynamic_chunk_state *state) : first(first), it(first), state(state) { next_block(); }
+
+      void next_block() {
+        std::tie(pos, block_end) = state->claim();
+        if (pos < block_end) it = first + pos;
+      }
+
+      void increment() {
+        ++it;
+        if (++pos == block_end) next_block();
+      }
+
+      bool operator==(dynamic_chunk_iter const &other) const { return pos == other.pos; }
+
+      bool operator==(sentinel_t<long> const &s) const { return pos == s.it; }
+
+      decltype(auto) dereference() const { return *it; }
+    };
+
+    // ---------------------------------------------
+
+    template <typename T> struct dynamic_chunked {
+      T x;
+      std::shared_ptr<dynamic_chunk_state> state;
+
+      using iterator       = dynamic_chunk_iter<decltype(std::begin(x))>;
+      using const_iterator = dynamic_chunk_iter<decltype(std::cbegin(x))>;
+
+      [[nodiscard]] iterator begin() noexcept { return {std::begin(x), state.get()}; }
+      [[nodiscard]] const_iterator cbegin() const noexcept { return {std::cbegin(x), state.get()}; }
+      [[nodiscard]] const_iterator begin() const noexcept { return cbegin(); }
+
+      [[nodiscard]] auto end() const noexcept { return make_sentinel(state->size); }
+      [[nodiscard]] auto cend() const noexcept { return end(); }
+    };
+
+  } // namespace detail
+
+  /**
+    * Function to chunk a range dynamically over all OMP threads.
+    *
+    * Threads repeatedly claim the next block of consecutive elements from a shared atomic counter.
+    * The blocks shrink with the number of remaining elements (guided), but contain at least grain elements.
+    * Unlike omp_chunk, threads that finish their blocks early take over the remaining work.
+    *
+    * This range-adapting function should be called by all threads inside an omp parallel region,
+    * like an omp worksharing construct. Each returned range should be iterated over exactly once.
+    *
+    * @tparam T The type of the range, required to be random-access
+    *
+    * @param range The range to chunk
+    * @param grain The minimal number of elements in a block
+    *
+    * @example
+    *
+    *      #pragma omp parallel
+    *      for (auto [i, j] : omp_dynamic_chunks(product_range(N, M), 16)) { ... }
+    */
+  template <typename T> auto omp_dynamic_chunks(T &&range, long grain = 1) {
+    static_assert(std::is_base_of_v<std::random_access_iterator_tag,
+                                    typename std::iterator_traits<decltype(std::cbegin(range))>::iterator_category>,
+                  "omp_dynamic_chunks requires a random-access range");
+    std::shared_ptr<detail::dynamic_chunk_state> state;
+#pragma omp single copyprivate(state)
+    state = std::make_shared<detail::dynamic_chunk_state>(itertools::distance(std::cbegin(range), std::cend(range)), std::max(grain, 1l),
+                                                          omp_get_num_threads());
+    return detail::dynamic_chunked<T>{std::forward<T>(range), std::move(state)};
+  }
 } // namespace itertools
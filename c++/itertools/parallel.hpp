@@ -0,0 +1,252 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <omp.h>
+
+#include <itertools/itertools.hpp>
+#include <itertools/omp_chunk.hpp>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace itertools {
+
+  /********************* Scheduling policies ********************/
+
+  /// Static OpenMP schedule. A chunk of zero splits the range into one contiguous block per thread.
+  struct omp_static_t {
+    long chunk = 0;
+  };
+  inline constexpr omp_static_t omp_static = {};
+
+  /// Dynamic OpenMP schedule, threads grab blocks of chunk elements
+  struct omp_dynamic_t {
+    long chunk = 1;
+  };
+  inline constexpr omp_dynamic_t omp_dynamic = {};
+
+  /// Guided OpenMP schedule, threads grab shrinking blocks of at least chunk elements
+  struct omp_guided_t {
+    long chunk = 1;
+  };
+  inline constexpr omp_guided_t omp_guided = {};
+
+  /**
+   * Work-stealing execution for uneven workloads on random-access ranges.
+   *
+   * The range is split recursively in halves, which are spawned as OpenMP tasks, until the pieces
+   * contain at most grain elements. Idle threads pick up the pending halves of busy ones.
+   * A grain of zero chooses a default of n / (16 * number of threads).
+   */
+  struct work_stealing_t {
+    long grain = 0;
+  };
+  inline constexpr work_stealing_t work_stealing = {};
+
+  namespace detail {
+
+    template <typename R> using iterator_category_t = typename std::iterator_traits<decltype(std::begin(std::declval<R &>()))>::iterator_category;
+
+    template <typename R> constexpr bool is_random_access_range_v = std::is_base_of_v<std::random_access_iterator_tag, iterator_category_t<R>>;
+
+    /*
+     * Call body(it) for the iterator to every element of r within the current parallel region.
+     *
+     * For random-access ranges the element indices are distributed by an orphaned omp for with
+     * the requested schedule. Each thread only repositions its iterator when its next index does
+     * not follow the previous one, i.e. once per chunk, and otherwise increments it.
+     *
+     * Other ranges are split statically with omp_chunk.
+     */
+    template <typename R, typename Body, typename Schedule> void omp_for_each_iter(R &r, Body &body, Schedule sched) {
+      if constexpr (is_random_access_range_v<R>) {
+        auto first  = std::begin(r);
+        long n      = itertools::distance(first, std::end(r));
+        auto it     = first;
+        long next_i = 0;
+        auto step   = [&](long i) {
+          if (i != next_i) it = first + i;
+          body(it);
+          ++it;
+          next_i = i + 1;
+        };
+        if constexpr (std::is_same_v<Schedule, omp_static_t>) {
+          if (sched.chunk > 0) {
+#pragma omp for schedule(static, sched.chunk)
+            for (long i = 0; i < n; ++i) step(i);
+          } else {
+#pragma omp for schedule(static)
+            for (long i = 0; i < n; ++i) step(i);
+          }
+        } else if constexpr (std::is_same_v<Schedule, omp_dynamic_t>) {
+#pragma omp for schedule(dynamic, sched.chunk)
+          for (long i = 0; i < n; ++i) step(i);
+        } else {
+          static_assert(std::is_same_v<Schedule, omp_guided_t>, "Unknown scheduling policy");
+#pragma omp for schedule(guided, sched.chunk)
+          for (long i = 0; i < n; ++i) step(i);
+        }
+      } else {
+        auto chunk = omp_chunk(r);
+        for (auto it = std::begin(chunk); it != std::end(chunk); ++it) body(it);
+#pragma omp barrier
+      }
+    }
+
+    // Process [first, first + n) by spawning the upper half as a task until at most grain elements remain
+    template <typename It, typename Body> void split_into_tasks(It first, long n, long grain, Body const *body) {
+      while (n > grain) {
+        long half = n / 2;
+        It mid    = first + (n - half);
+#pragma omp task firstprivate(mid, half, grain, body)
+        split_into_tasks(mid, half, grain, body);
+        n -= half;
+      }
+      for (long i = 0; i < n; ++i, ++first) (*body)(first);
+    }
+
+    /*
+     * Work-stealing version of omp_for_each_iter.
+     *
+     * Each thread registers its own body, such that tasks always call the body of the thread executing them.
+     * All tasks are complete at the implicit barrier of the single construct.
+     */
+    template <typename R, typename Body> void omp_for_each_iter(R &r, Body &body, work_stealing_t ws) {
+      static_assert(is_random_access_range_v<R>, "Work-stealing execution requires a random-access range");
+      auto first = std::begin(r);
+      long n     = itertools::distance(first, std::end(r));
+
+      std::shared_ptr<std::vector<Body *>> bodies;
+#pragma omp single copyprivate(bodies)
+      bodies = std::make_shared<std::vector<Body *>>(omp_get_num_threads());
+      (*bodies)[omp_get_thread_num()] = &body;
+#pragma omp barrier
+
+      auto thread_body = [&bodies](auto const &it) { (*(*bodies)[omp_get_thread_num()])(it); };
+      long grain       = ws.grain > 0 ? ws.grain : std::max(1l, n / (16l * omp_get_num_threads()));
+#pragma omp single
+      split_into_tasks(first, n, grain, &thread_body);
+    }
+
+  } // namespace detail
+
+  /**
+   * Apply a function to every element of a range in parallel using OpenMP.
+   *
+   * The function opens its own parallel region. Any range adapted by itertools can be used,
+   * e.g. range, product_range, zip, enumerate or slice. For random-access ranges the elements are
+   * distributed according to the given schedule. Other ranges are always split statically.
+   *
+   * @param r The range to iterate over
+   * @param f The function to apply to every element
+   * @param sched The scheduling policy: omp_static (default), omp_dynamic, omp_guided or work_stealing
+   *
+   * @example
+   *
+   *      parallel_for(product_range(N, M), [&](auto idx) { auto [i, j] = idx; A(i, j) = i + j; });
+   *      parallel_for(range(N), f, omp_dynamic_t{16});
+   *      parallel_for(product_range(N, N), triangular_work, work_stealing);
+   */
+  template <typename R, typename F, typename Schedule = omp_static_t> void parallel_for(R &&r, F &&f, Schedule sched = {}) {
+    auto body = [&f](auto const &it) { f(*it); };
+#pragma omp parallel
+    detail::omp_for_each_iter(r, body, sched);
+  }
+
+  /**
+   * Map every element of a range with f and reduce the results with op in parallel using OpenMP.
+   *
+   * Each thread accumulates its elements into a thread-local value. The partial results are
+   * combined with init in the order of the thread numbers, such that the result is
+   * reproducible for a fixed number of threads and a static schedule.
+   *
+   * With the default omp_static schedule, every thread gets one contiguous block of elements in the order
+   * of the thread numbers, and op only needs to be associative. With a chunk size or any other schedule,
+   * a thread accumulates blocks that are not adjacent, or in an arbitrary order, and op must also be commutative.
+   *
+   * @param r The range to iterate over
+   * @param init The initial value of the reduction
+   * @param op The binary reduction operation, associative and, unless the default schedule is used, commutative
+   * @param f The function to apply to every element
+   * @param sched The scheduling policy: omp_static (default), omp_dynamic, omp_guided or work_stealing
+   * @return op(...op(op(init, f(x_0)), f(x_1))..., f(x_{n-1})), up to reassociation for the default schedule
+   *         and up to reassociation and reordering otherwise
+   *
+   * @example
+   *
+   *      auto dot = parallel_reduce(zip(a, b), 0.0, std::plus<>{}, [](auto x) { auto [ai, bi] = x; return ai * bi; });
+   */
+  template <typename R, typename T, typename Op, typename F, typename Schedule = omp_static_t>
+  T parallel_reduce(R &&r, T init, Op &&op, F &&f, Schedule sched = {}) {
+    std::vector<std::optional<T>> partials(omp_get_max_threads());
+#pragma omp parallel
+    {
+      std::optional<T> acc;
+      auto body = [&](auto const &it) {
+        if (acc)
+          acc = op(std::move(*acc), f(*it));
+        else
+          acc.emplace(f(*it));
+      };
+      detail::omp_for_each_iter(r, body, sched);
+      partials[omp_get_thread_num()] = std::move(acc);
+    }
+    for (auto &p : partials)
+      if (p) init = op(std::move(init), std::move(*p));
+    return init;
+  }
+
+  /**
+   * Collect the elements of a random-access range into a std::vector in parallel using OpenMP.
+   *
+   * Every thread evaluates the elements of its chunk_range, constructing them in place in a buffer of
+   * its own, such that expensive transforms are computed concurrently. The buffers are then moved
+   * into the result in order. The result is the same as that of make_vector_from_range, and the elements
+   * are only required to be move-constructible. For cheap elements the final move dominates and
+   * make_vector_from_range is preferable.
+   * The function opens its own parallel region.
+   *
+   * @param r The random-access range to collect
+   * @return A std::vector holding the elements of r in order
+   *
+   * @example
+   *
+   *      auto H = parallel_make_vector_from_range(transform(product_range(N, N), matrix_element));
+   */
+  template <typename R> auto parallel_make_vector_from_range(R const &r) {
+    static_assert(detail::is_random_access_range_v<R const>, "parallel_make_vector_from_range requires a random-access range");
+    using value_t = detail::range_value_t<R>;
+    auto first    = std::cbegin(r);
+    long n        = itertools::distance(first, std::cend(r));
+
+    std::vector<std::vector<value_t>> chunks(omp_get_max_threads());
+#pragma omp parallel
+    {
+      auto [start_idx, end_idx] = chunk_range(0, n, omp_get_num_threads(), omp_get_thread_num());
+      auto &chunk               = chunks[omp_get_thread_num()];
+      chunk.reserve(end_idx - start_idx);
+      auto it = first + start_idx;
+      for (long i = start_idx; i < end_idx; ++i, ++it) chunk.emplace_back(*it);
+    }
+
+    std::vector<value_t> vec;
+    vec.reserve(n);
+    for (auto &chunk : chunks) std::move(chunk.begin(), chunk.end(), std::back_inserter(vec));
+    return vec;
+  }
+
+} // namespace itertools
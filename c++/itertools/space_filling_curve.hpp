@@ -0,0 +1,350 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <itertools/itertools.hpp>
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
+namespace itertools {
+
+  namespace detail {
+
+    // Extract the bits of x selected by mask into the low bits of the result
+    inline std::uint64_t extract_bits(std::uint64_t x, std::uint64_t mask) {
+#ifdef __BMI2__
+      return _pext_u64(x, mask);
+#else
+      std::uint64_t res = 0;
+      for (std::uint64_t bit = 1; mask != 0; bit <<= 1, mask &= mask - 1)
+        if (x & mask & -mask) res |= bit;
+      return res;
+#endif
+    }
+
+    /*
+     * Bit interleaving of the indices of a Rank-dimensional index space.
+     *
+     * Dimension d uses the number of bits required by its extent. At every bit level the dimensions
+     * which still have bits contribute one bit to the code, the last dimension in the lowest position.
+     * Decoding the code then extracts the bits of every dimension with its mask.
+     */
+    template <size_t Rank> struct morton_codec {
+      std::array<std::uint64_t, Rank> masks = {};
+      int n_bits                            = 0;
+
+      morton_codec() = default;
+      explicit morton_codec(std::array<int, Rank> const &bits) {
+        int max_bits = *std::max_element(bits.begin(), bits.end()), pos = 0;
+        for (int b = 0; b < max_bits; ++b)
+          for (int d = Rank - 1; d >= 0; --d)
+            if (b < bits[d]) masks[d] |= std::uint64_t{1} << pos++;
+        if (pos >= 64) throw std::runtime_error("Space-filling curve: the index space is too large for a 64-bit code");
+        n_bits = pos;
+      }
+
+      [[nodiscard]] std::uint64_t n_codes() const { return std::uint64_t{1} << n_bits; }
+
+      [[nodiscard]] std::array<long, Rank> decode(std::uint64_t code) const {
+        std::array<long, Rank> x;
+        for (size_t d = 0; d < Rank; ++d) x[d] = long(extract_bits(code, masks[d]));
+        return x;
+      }
+
+      // Number of low bits of every index which vary over the codes [code, code + 2^t), with code a multiple of 2^t
+      [[nodiscard]] std::array<int, Rank> free_bits(std::uint64_t, int t) const {
+        std::array<int, Rank> b;
+        for (size_t d = 0; d < Rank; ++d) b[d] = std::popcount(masks[d] & ((std::uint64_t{1} << t) - 1));
+        return b;
+      }
+    };
+
+    /*
+     * Compact Hilbert index of a Rank-dimensional index space, decoded with the algorithm of
+     * C. H. Hamilton and A. Rau-Chaplin, "Compact Hilbert indices", Inf. Process. Lett. 105, 155 (2008).
+     *
+     * Dimension d uses the number of bits required by its extent, as for morton_codec. The order of the
+     * indices is the one of the Hilbert curve on the cube of the largest extent, while the codes number
+     * only the points of the padded box. At bit level i, the dimensions which still have bits contribute
+     * one bit each to the code, taken as the rank of the corresponding Gray code among the sub-cubes of the box.
+     */
+    template <size_t Rank> struct hilbert_codec {
+      static_assert(Rank <= 32, "hilbert_codec supports at most 32 dimensions");
+
+      std::array<int, Rank> bits      = {};
+      std::array<unsigned, 64> active = {}; // Mask of the dimensions with a bit at every level
+      int n_levels = 0, n_bits = 0;
+
+      hilbert_codec() = default;
+      explicit hilbert_codec(std::array<int, Rank> const &bits) : bits(bits) {
+        n_levels = *std::max_element(bits.begin(), bits.end());
+        for (int i = 0; i < n_levels; ++i)
+          for (size_t d = 0; d < Rank; ++d)
+            if (i < bits[d]) active[i] |= 1u << d, ++n_bits;
+        if (n_bits >= 64) throw std::runtime_error("Space-filling curve: the index space is too large for a 64-bit code");
+      }
+
+      [[nodiscard]] std::uint64_t n_codes() const { return std::uint64_t{1} << n_bits; }
+
+      [[nodiscard]] std::array<long, Rank> decode(std::uint64_t code) const {
+        std::array<long, Rank> x = {};
+        walk(code, 0, [&x](int i, unsigned l, unsigned) {
+          for (size_t d = 0; d < Rank; ++d) x[d] |= long((l >> d) & 1u) << i;
+        });
+        return x;
+      }
+
+      // Number of low bits of every index which vary over the codes [code, code + 2^t), with code a multiple of 2^t
+      [[nodiscard]] std::array<int, Rank> free_bits(std::uint64_t code, int t) const {
+        std::array<int, Rank> b = {};
+        walk(code, t, [&b, this](int i, unsigned, unsigned varying) {
+          if (varying != 0)
+            for (size_t d = 0; d < Rank; ++d) b[d] = std::min(i, bits[d]) + int((varying >> d) & 1u);
+        });
+        return b;
+      }
+
+      private:
+      static unsigned rotl(unsigned x, int k) { return k == 0 ? x : ((x << k) | (x >> (Rank - k))) & (~0u >> (32 - Rank)); }
+      static unsigned rotr(unsigned x, int k) { return rotl(x, (Rank - k) % Rank); }
+
+      // Apply f(level, index bits, dimensions varying in the block) from the highest level down to the level of bit t
+      template <typename F> void walk(std::uint64_t code, int t, F &&f) const {
+        unsigned e = 0;
+        int dir = 0, k = n_bits;
+        for (int i = n_levels - 1; i >= 0; --i) {
+          unsigned mu = rotr(active[i], (dir + 1) % Rank), pi = rotr(e, (dir + 1) % Rank) & ~mu;
+          int n_free  = std::popcount(mu);
+          k -= n_free;
+          auto r = unsigned((code >> k) & ((std::uint64_t{1} << n_free) - 1));
+
+          // Inverse of the Gray code rank, the bits outside of mu being fixed by pi
+          unsigned w = 0, varying = 0;
+          for (int j = Rank - 1, n = n_free - 1, n_varying = std::clamp(t - k, 0, n_free); j >= 0; --j) {
+            unsigned wj = 0;
+            if ((mu >> j) & 1u) {
+              wj = (r >> n) & 1u;
+              if (n-- < n_varying) varying |= 1u << j;
+            } else
+              wj = ((pi >> j) & 1u) ^ ((w >> (j + 1)) & 1u);
+            w |= wj << j;
+          }
+          unsigned l = rotl(w ^ (w >> 1), (dir + 1) % Rank) ^ e;
+
+          if (k < t) return f(i, l, rotl(varying, (dir + 1) % Rank));
+          f(i, l, 0);
+
+          // Entry point and direction of the sub-cube w
+          unsigned entry = w == 0 ? 0 : ((w - 1) & ~1u) ^ (((w - 1) & ~1u) >> 1);
+          int d_w        = w == 0 ? 0 : std::countr_one(w % 2 == 0 ? w - 1 : w) % int(Rank);
+          e ^= rotl(entry, (dir + 1) % Rank);
+          dir = (dir + d_w + 1) % int(Rank);
+        }
+      }
+    };
+
+    /********************* Space-filling curve Iterator ********************/
+
+    /*
+     * Iterator over the codes [code, code_end) of a space-filling curve.
+     *
+     * The curve covers a power-of-two padded index space, codes which decode to an index
+     * outside of the extents are skipped.
+     */
+    template <size_t Rank, typename Codec>
+    struct curve_iter : iterator_facade<curve_iter<Rank, Codec>, long_tuple_t<Rank>, std::forward_iterator_tag, long_tuple_t<Rank>> {
+
+      Codec codec                = {};
+      std::array<long, Rank> ext = {}, idx = {};
+      std::uint64_t code = 0, code_end = 0;
+
+      curve_iter() = default;
+      curve_iter(Codec const &codec, std::array<long, Rank> const &ext, std::uint64_t code, std::uint64_t code_end)
+         : codec(codec), ext(ext), code(code), code_end(code_end) {
+        _skip_invalid();
+      }
+
+      private:
+      void _skip_invalid() {
+        for (; code < code_end; ++code) {
+          idx = codec.decode(code);
+          bool valid = true;
+          for (size_t d = 0; d < Rank; ++d) valid &= (idx[d] < ext[d]);
+          if (valid) return;
+        }
+      }
+
+      public:
+      void increment() {
+        ++code;
+        _skip_invalid();
+      }
+
+      bool operator==(curve_iter const &other) const { return code == other.code; }
+
+      bool operator==(sentinel_t<std::uint64_t> const &s) const { return code == s.it; }
+
+      [[nodiscard]] long_tuple_t<Rank> dereference() const {
+        return [this]<size_t... Is>(std::index_sequence<Is...>) { return long_tuple_t<Rank>{idx[Is]...}; }(std::make_index_sequence<Rank>{});
+      }
+    };
+
+    // ---------------------------------------------
+
+    template <size_t Rank, typename Codec> struct curve_range {
+      Codec codec;
+      std::array<long, Rank> ext;
+      std::uint64_t code_begin = 0, code_end = 0;
+
+      using iterator       = curve_iter<Rank, Codec>;
+      using const_iterator = iterator;
+
+      curve_range(Codec codec, std::array<long, Rank> const &ext) : codec(std::move(codec)), ext(ext) {
+        bool empty = std::any_of(ext.begin(), ext.end(), [](long e) { return e <= 0; });
+        code_end   = empty ? 0 : this->codec.n_codes();
+      }
+
+      /// Extents of the index space
+      [[nodiscard]] std::array<long, Rank> const &extents() const { return ext; }
+
+      /**
+       * Split the range into n_chunks contiguous pieces of the curve and return piece number rank.
+       * The pieces contain equal numbers of indices, see chunk_range.
+       */
+      [[nodiscard]] curve_range chunk(long n_chunks, long rank) const {
+        auto [start, end] = chunk_range(long(n_valid_before(code_begin)), long(n_valid_before(code_end)), n_chunks, rank);
+        auto res          = *this;
+        res.code_begin    = std::max(code_begin, first_code_with(start));
+        res.code_end      = std::min(code_end, first_code_with(end));
+        return res;
+      }
+
+      private:
+      // Number of indices within the extents among the codes [code, code + 2^t), with code a multiple of 2^t
+      [[nodiscard]] std::uint64_t n_valid_in_block(std::uint64_t code, int t) const {
+        auto x          = codec.decode(code);
+        auto b          = codec.free_bits(code, t);
+        std::uint64_t n = 1;
+        for (size_t d = 0; d < Rank; ++d) n *= std::clamp(ext[d] - (x[d] >> b[d] << b[d]), 0l, 1l << b[d]);
+        return n;
+      }
+
+      // Number of indices within the extents among the codes [0, code)
+      [[nodiscard]] std::uint64_t n_valid_before(std::uint64_t code) const {
+        std::uint64_t n = 0, base = 0;
+        for (int t = 63; t >= 0; --t)
+          if ((code >> t) & 1u) {
+            n += n_valid_in_block(base, t);
+            base += std::uint64_t{1} << t;
+          }
+        return n;
+      }
+
+      // Smallest code c with n_valid_before(c) >= n
+      [[nodiscard]] std::uint64_t first_code_with(long n) const {
+        if (n <= 0) return 0;
+        std::uint64_t base = 0, n_before = 0;
+        for (int t = std::bit_width(codec.n_codes()) - 1; t >= 0; --t) {
+          auto n_block = n_valid_in_block(base, t);
+          if (n_before + n_block < std::uint64_t(n)) {
+            n_before += n_block;
+            base += std::uint64_t{1} << t;
+          }
+        }
+        return base + 1;
+      }
+
+      public:
+
+      [[nodiscard]] iterator cbegin() const { return {codec, ext, code_begin, code_end}; }
+      [[nodiscard]] iterator begin() const { return cbegin(); }
+
+      [[nodiscard]] auto cend() const { return make_sentinel(code_end); }
+      [[nodiscard]] auto end() const { return cend(); }
+    };
+
+    // Number of bits required to represent the indices [0, n)
+    inline int bits_for(long n) { return n <= 1 ? 0 : int(std::bit_width(std::uint64_t(n - 1))); }
+
+  } // namespace detail
+
+  /**
+   * Product of integer ranges [0, N_k), visited in Morton (Z-) order.
+   *
+   * Yields the same tuples of indices as product_range(Is...), but traverses the index space along
+   * a Z-order curve, which preserves locality in all directions at once. The curve covers each
+   * extent padded to the next power of two, with the positions outside of the extents skipped.
+   * The bits are decoded with the BMI2 instruction pext when available.
+   *
+   * The range can be split along the curve with omp_chunk or mpi_chunk. The pieces contain equal numbers of tuples.
+   *
+   * @tparam Integers The integer types
+   * @param Is The extents of the integer ranges
+   *
+   * @example
+   *
+   *      for (auto [i, j, k] : morton_product_range(N, N, N)) { ... }
+   */
+  template <typename... Integers>
+     requires(std::is_integral_v<Integers> and ...)
+  auto morton_product_range(Integers... Is) {
+    static_assert(sizeof...(Integers) > 0, "morton_product_range requires at least one extent");
+    constexpr size_t Rank = sizeof...(Integers);
+    std::array<long, Rank> ext{long(Is)...};
+    return detail::curve_range<Rank, detail::morton_codec<Rank>>{detail::morton_codec<Rank>{{detail::bits_for(long(Is))...}}, ext};
+  }
+
+  /**
+   * Product of integer ranges [0, N_k), visited in Hilbert curve order.
+   *
+   * Yields the same tuples of indices as product_range(Is...), but traverses the index space along
+   * a Hilbert curve. The order is the one of the Hilbert curve on the cube of the largest extent, but the
+   * codes cover only each extent padded to the next power of two, as for morton_product_range, with the
+   * positions outside of the extents skipped. Consecutive tuples are neighbours if all extents are equal
+   * powers of two, and mostly close otherwise.
+   *
+   * The range can be split along the curve with omp_chunk or mpi_chunk. The pieces contain equal numbers of tuples.
+   *
+   * @tparam Integers The integer types
+   * @param Is The extents of the integer ranges
+   *
+   * @example
+   *
+   *      for (auto [i, j] : hilbert_product_range(N, N)) { ... }
+   */
+  template <typename... Integers>
+     requires(std::is_integral_v<Integers> and ...)
+  auto hilbert_product_range(Integers... Is) {
+    static_assert(sizeof...(Integers) > 0, "hilbert_product_range requires at least one extent");
+    constexpr size_t Rank = sizeof...(Integers);
+    std::array<long, Rank> ext{long(Is)...};
+    return detail::curve_range<Rank, detail::hilbert_codec<Rank>>{detail::hilbert_codec<Rank>{{detail::bits_for(long(Is))...}}, ext};
+  }
+
+} // namespace itertools
+
+namespace std::ranges {
+
+  template <size_t Rank, typename Codec> inline constexpr bool enable_view<itertools::detail::curve_range<Rank, Codec>>            = true;
+  template <size_t Rank, typename Codec> inline constexpr bool enable_borrowed_range<itertools::detail::curve_range<Rank, Codec>> = true;
+
+} // namespace std::ranges
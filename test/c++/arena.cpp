@@ -0,0 +1,102 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <itertools/arena.hpp>
+#include <itertools/itertools.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory_resource>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace itertools;
+
+TEST(Arena, Allocate) {
+
+  arena ar(128);
+  EXPECT_EQ(ar.n_blocks(), 0);
+
+  // Allocations are aligned and do not overlap
+  auto *c = static_cast<char *>(ar.allocate(1, 1));
+  auto *d = static_cast<double *>(ar.allocate(3 * sizeof(double), alignof(double)));
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(d) % alignof(double), 0);
+  EXPECT_TRUE(reinterpret_cast<char *>(d) >= c + 1);
+  auto *v = ar.allocate(64, 64);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(v) % 64, 0);
+
+  // Allocations larger than a block get their own
+  EXPECT_NE(ar.allocate(1000), nullptr);
+  EXPECT_GE(ar.n_blocks(), 2);
+  auto cap = ar.capacity();
+  EXPECT_GE(cap, 1000);
+
+  // Reset merges the blocks, such that the same allocations fit into one
+  ar.reset();
+  EXPECT_EQ(ar.n_blocks(), 1);
+  EXPECT_EQ(ar.capacity(), cap);
+  for (auto [bytes, alignment] : {std::pair{1, 1}, {3 * sizeof(double), alignof(double)}, {64, 64}, {1000, alignof(std::max_align_t)}})
+    EXPECT_NE(ar.allocate(bytes, alignment), nullptr);
+  EXPECT_EQ(ar.n_blocks(), 1);
+}
+
+TEST(Arena, Collect) {
+
+  std::vector<int> a{1, 2, 3, 4}, b{5, 6, 7, 8};
+  auto sq = [](long i) { return i * i; };
+
+  // collect with the default allocator
+  EXPECT_EQ(collect<std::vector>(transform(range(4), sq)), (std::vector<long>{0, 1, 4, 9}));
+  EXPECT_EQ(collect<std::deque>(range(3)), (std::deque<long>{0, 1, 2}));
+  EXPECT_EQ(collect<std::list<int>>(a), (std::list<int>{1, 2, 3, 4}));
+  EXPECT_EQ(collect<std::set<long>>(transform(range(-3, 3), sq)), (std::set<long>{0, 1, 4, 9}));
+
+  // collect into an arena, with the allocator rebound to the element type
+  arena ar;
+  for (int sweep = 0; sweep < 3; ++sweep) {
+    ar.reset();
+    auto z = collect<std::vector>(zip(a, b), arena_allocator<std::byte>{ar});
+    static_assert(std::is_same_v<decltype(z)::allocator_type, arena_allocator<decltype(z)::value_type>>);
+    EXPECT_EQ(z.size(), 4);
+    EXPECT_EQ(z[2], std::make_tuple(3, 7));
+    auto p = collect<arena_vector<std::tuple<long, long>>>(product_range(2, 3), ar);
+    EXPECT_EQ(p.size(), 6);
+    EXPECT_EQ(p.capacity(), 6);
+    auto [xs, ys] = collect_soa(zip(a, b), arena_allocator<std::byte>{ar});
+    static_assert(std::is_same_v<decltype(xs), arena_vector<int>>);
+    EXPECT_EQ(ys[3], 8);
+    EXPECT_EQ(ar.n_blocks(), 1);
+  }
+
+  // collect with a polymorphic allocator
+  std::pmr::monotonic_buffer_resource res;
+  auto s = collect<std::pmr::vector<std::pmr::string>>(transform(range(3), [](long i) { return std::to_string(i); }), &res);
+  EXPECT_EQ(s[2], "2");
+}
+
+TEST(Arena, ThreadLocal) {
+
+  EXPECT_EQ(&thread_local_arena(), &thread_local_arena());
+
+#pragma omp parallel for num_threads(4)
+  for (int t = 0; t < 4; ++t) {
+    auto &ar = thread_local_arena();
+    ar.reset();
+    auto v = collect<std::vector>(transform(range(100), [t](long i) { return i + t; }), arena_allocator<long>{ar});
+    EXPECT_EQ(v[99], 99 + t);
+  }
+}
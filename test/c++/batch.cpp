@@ -0,0 +1,81 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <itertools/batch.hpp>
+
+#include <array>
+#include <numeric>
+#include <vector>
+
+using namespace itertools;
+
+TEST(Batch, Range) {
+
+  // Collect the indices and the batch sizes
+  std::vector<long> indices, sizes;
+  auto collect = [&](auto idx) {
+    sizes.push_back(idx.size());
+    for (size_t i = 0; i < idx.size(); ++i) indices.push_back(idx[i]);
+  };
+
+  for_each_batch<4>(range(1, 12, 2), collect);
+  EXPECT_EQ(indices, (std::vector<long>{1, 3, 5, 7, 9, 11}));
+  EXPECT_EQ(sizes, (std::vector<long>{4, 1, 1}));
+
+  indices.clear();
+  sizes.clear();
+  for_each_batch<4>(range(8), collect);
+  EXPECT_EQ(indices, make_vector_from_range(range(8)));
+  EXPECT_EQ(sizes, (std::vector<long>{4, 4}));
+
+  indices.clear();
+  for_each_batch<4>(range(0), collect);
+  EXPECT_TRUE(indices.empty());
+}
+
+TEST(Batch, Zip) {
+
+  // SAXPY with a tail
+  for (long N : {0, 3, 16, 21}) {
+    std::vector<float> x(N), y(N, 1.0);
+    std::iota(x.begin(), x.end(), 0.0);
+    for_each_batch<8>(zip(x, y), [](auto xs, auto ys) {
+      for (size_t i = 0; i < xs.size(); ++i) ys[i] += 2 * xs[i];
+    });
+    for (long i = 0; i < N; ++i) EXPECT_EQ(y[i], 1 + 2 * i);
+  }
+
+  // Zip with a const array and a range, stops at the shortest component
+  std::array<int, 10> const a{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  std::vector<long> res(20, -1);
+  for_each_batch<4>(zip(a, range(100, 200), res), [](auto as, auto idx, auto rs) {
+    for (size_t i = 0; i < as.size(); ++i) rs[i] = as[i] + idx[i];
+  });
+  for (long i = 0; i < 20; ++i) EXPECT_EQ(res[i], i < 10 ? 100 + 2 * i : -1);
+}
+
+TEST(Batch, Enumerate) {
+
+  std::vector<double> v(13, 0.0);
+  for_each_batch<4>(enumerate(v), [](auto idx, auto vs) {
+    for (size_t i = 0; i < idx.size(); ++i) vs[i] = double(idx[i] * idx[i]);
+  });
+  for (long i = 0; i < 13; ++i) EXPECT_EQ(v[i], i * i);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,111 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <itertools/cached_transform.hpp>
+#include <itertools/omp_chunk.hpp>
+
+#include <atomic>
+#include <forward_list>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace itertools;
+
+TEST(CachedTransform, RandomAccess) {
+
+  long n_calls = 0;
+  auto sq      = [&n_calls](long i) {
+    ++n_calls;
+    return i * i;
+  };
+  auto c = cached_transform(range(10), sq);
+  static_assert(std::ranges::random_access_range<decltype(c)>);
+  static_assert(std::ranges::sized_range<decltype(c)>);
+  EXPECT_EQ(c.size(), 10);
+
+  // Iterating twice computes every element once
+  std::vector<long> expected{0, 1, 4, 9, 16, 25, 36, 49, 64, 81};
+  EXPECT_EQ(make_vector_from_range(c), expected);
+  EXPECT_EQ(make_vector_from_range(c), expected);
+  EXPECT_EQ(n_calls, 10);
+
+  // Repeated dereferencing, random access and copies of the range reuse the values
+  auto c2 = cached_transform(range(10), sq);
+  n_calls = 0;
+  auto it = c2.begin() + 7;
+  EXPECT_EQ(*it, 49);
+  EXPECT_EQ(*it, 49);
+  EXPECT_EQ(c2.begin()[7], 49);
+  auto copy = c2;
+  EXPECT_EQ(*(copy.begin() + 7), 49);
+  EXPECT_EQ(n_calls, 1);
+  EXPECT_EQ(std::accumulate(c2.begin(), c2.begin() + 10, 0l), 285);
+  EXPECT_EQ(n_calls, 10);
+}
+
+TEST(CachedTransform, Forward) {
+
+  std::forward_list<int> L{1, 2, 3, 4};
+  long n_calls = 0;
+  auto c       = cached_transform(L, [&n_calls](int i) {
+    ++n_calls;
+    return std::to_string(i);
+  });
+  static_assert(std::ranges::forward_range<decltype(c)>);
+
+  // Every value is computed once
+  auto it = c.begin();
+  EXPECT_EQ(*it, "1");
+  EXPECT_EQ(it->size(), 1);
+  EXPECT_EQ(n_calls, 1);
+  ++it;
+  EXPECT_EQ(*it, "2");
+  EXPECT_EQ(n_calls, 2);
+
+  std::string res;
+  for (auto const &s : c) res += s;
+  EXPECT_EQ(res, "1234");
+  EXPECT_EQ(n_calls, 4);
+
+  // The references do not depend on the iterator they were obtained from
+  auto b                = c.begin();
+  std::string const &r  = *b++;
+  std::string const &r2 = *b;
+  EXPECT_EQ(r, "1");
+  EXPECT_EQ(r2, "2");
+  auto b2 = std::next(c.begin());
+  EXPECT_TRUE(b == b2);
+  EXPECT_EQ(&*b, &*b2);
+  EXPECT_EQ(n_calls, 4);
+}
+
+TEST(CachedTransform, OmpChunk) {
+
+  long N = 1000;
+  std::vector<std::atomic<int>> n_calls(N);
+  auto c = cached_transform(range(N), [&n_calls](long i) {
+    ++n_calls[i];
+    return 2 * i;
+  });
+
+  // The threads fill disjoint parts of the buffer
+  for (int sweep = 0; sweep < 3; ++sweep) {
+#pragma omp parallel
+    for (long x : omp_chunk(c)) EXPECT_EQ(x % 2, 0);
+  }
+  for (auto &k : n_calls) EXPECT_EQ(k, 1);
+  EXPECT_EQ(std::accumulate(c.begin(), c.begin() + N, 0l), N * (N - 1));
+}
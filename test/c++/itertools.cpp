@@ -17,9 +17,15 @@
 #include <gtest/gtest.h>
 #include <itertools/itertools.hpp>
 
+#include <algorithm>
 #include <array>
+#include <deque>
+#include <forward_list>
+#include <list>
+#include <span>
 #include <vector>
 #include <numeric>
+#include <ranges>
 
 using namespace itertools;
 
@@ -71,6 +77,171 @@ TEST(Itertools, Enumerate) {
   }
 }
 
+TEST(Itertools, Contiguous) {
+
+  std::vector<int> V{1, 2, 3, 4, 5, 6};
+  std::array<double, 4> const A{1.5, 2.5, 3.5, 4.5};
+  int C[5] = {10, 20, 30, 40, 50};
+  std::list<int> L{1, 2, 3};
+
+  // Contiguous ranges share a single index
+  static_assert(std::is_same_v<decltype(zip(V, A).begin()), detail::contiguous_zip_iter<int, double const>>);
+  static_assert(std::is_same_v<decltype(zip(V, std::span{C}).begin()), detail::contiguous_zip_iter<int, int>>);
+  static_assert(std::is_same_v<decltype(enumerate(V).cbegin()), detail::contiguous_enum_iter<int const>>);
+  static_assert(std::is_same_v<decltype(zip(slice(V, 1, 3), C).begin()), detail::contiguous_zip_iter<int, int>>);
+  static_assert(not std::is_same_v<decltype(zip(V, L).begin()), detail::contiguous_zip_iter<int, int>>);
+
+  // Zip stops at the shortest range and can modify the elements
+  std::vector<std::tuple<int, double, int>> res;
+  for (auto [v, a, c] : zip(V, A, C)) {
+    res.emplace_back(v, a, c);
+    c += v;
+  }
+  EXPECT_EQ(res, (std::vector<std::tuple<int, double, int>>{{1, 1.5, 10}, {2, 2.5, 20}, {3, 3.5, 30}, {4, 4.5, 40}}));
+  EXPECT_EQ(C[3], 44);
+  EXPECT_EQ(C[4], 50);
+
+  // Random access, slices and const zips
+  auto const z = zip(V, C);
+  EXPECT_EQ(z.end() - z.begin(), 5);
+  EXPECT_EQ(*(z.begin() + 2), std::make_tuple(3, 33));
+  auto values = [](auto const &r) {
+    std::vector<std::tuple<int, int>> vec;
+    for (auto [x, y] : r) vec.emplace_back(x, y);
+    return vec;
+  };
+  EXPECT_EQ(values(slice(z, 3, 10)), (std::vector<std::tuple<int, int>>{{4, 44}, {5, 50}}));
+  EXPECT_EQ(values(zip(slice(V, 2, 4), slice(V, 4, 6))), (std::vector<std::tuple<int, int>>{{3, 5}, {4, 6}}));
+
+  // Enumerate
+  for (auto [i, v] : enumerate(V)) v *= int(i);
+  EXPECT_EQ(V, (std::vector<int>{0, 2, 6, 12, 20, 30}));
+  auto e = enumerate(A);
+  EXPECT_EQ(e.end() - e.begin(), 4);
+  EXPECT_EQ(*(e.begin() + 3), std::make_tuple(3, 4.5));
+  EXPECT_TRUE(values(zip(V, std::vector<int>{})).empty());
+}
+
+TEST(Itertools, Sized_Zip) {
+
+  std::list<int> L{1, 2, 3, 4};
+  std::forward_list<int> FL{1, 2, 3};
+  std::vector<int> V{10, 20, 30};
+  auto sq = [](int i) { return i * i; };
+
+  // Sized ranges end with a single counter at the length of the shortest range
+  static_assert(std::is_same_v<decltype(zip(L, range(10), V).end()), sentinel_t<std::ptrdiff_t>>);
+  static_assert(not std::is_same_v<decltype(zip(L, FL).end()), sentinel_t<std::ptrdiff_t>>);
+
+  std::vector<std::tuple<int, long, int>> res;
+  for (auto [l, i, v] : zip(L, range(10), V)) res.emplace_back(l, i, v);
+  EXPECT_EQ(res, (std::vector<std::tuple<int, long, int>>{{1, 0, 10}, {2, 1, 20}, {3, 2, 30}}));
+
+  auto z = zip(range(5), L);
+  EXPECT_EQ(itertools::distance(z.begin(), z.end()), 4);
+  auto it = std::next(z.begin(), 4);
+  EXPECT_TRUE(it == z.end());
+  EXPECT_EQ(*std::prev(it), std::make_tuple(3, 4));
+
+  // Random access
+  auto zr = zip(range(2, 20), stride(V, 2));
+  EXPECT_EQ(zr.end() - zr.begin(), 2);
+  EXPECT_EQ(*(zr.begin() + 1), std::make_tuple(3, 30));
+
+  // Unsized ranges fall back to comparing every component
+  long count = 0;
+  for (auto [l, s] : zip(L, transform(FL, sq))) count += s - l * l + 1;
+  EXPECT_EQ(count, 3);
+}
+
+TEST(Itertools, Zip_Sort) {
+
+  std::vector<int> V{3, 1, 2, 1};
+  std::vector<double> W{0.3, 0.1, 0.2, 0.0};
+  std::deque<long> D{4, 3, 2, 1};
+
+  static_assert(std::sortable<decltype(zip(V, W).begin())>);
+  static_assert(std::sortable<decltype(zip(D, V).begin())>);
+  static_assert(not std::sortable<decltype(zip(V, range(4)).begin())>);
+
+  // Sorting a zip permutes all components together
+  auto z = zip(V, W);
+  std::sort(z.begin(), z.begin() + z.size());
+  EXPECT_EQ(V, (std::vector<int>{1, 1, 2, 3}));
+  EXPECT_EQ(W, (std::vector<double>{0.0, 0.1, 0.2, 0.3}));
+
+  std::ranges::sort(zip(V, W), std::greater{}, [](auto const &t) { return std::get<1>(t); });
+  EXPECT_EQ(V, (std::vector<int>{3, 2, 1, 1}));
+
+  // Also for non-contiguous ranges, and through iter_swap and assignment of the references
+  std::ranges::sort(zip(D, V));
+  EXPECT_EQ(D, (std::deque<long>{1, 2, 3, 4}));
+  EXPECT_EQ(V, (std::vector<int>{1, 1, 2, 3}));
+  std::iter_swap(z.begin(), z.begin() + 3);
+  *(zip(D, V).begin() + 1) = std::make_tuple(20l, 10);
+  EXPECT_EQ(V, (std::vector<int>{3, 10, 2, 1}));
+  EXPECT_EQ(D[1], 20);
+  EXPECT_EQ(W, (std::vector<double>{0.0, 0.2, 0.1, 0.3}));
+}
+
+TEST(Itertools, Std_Ranges) {
+
+  std::vector<int> V{1, 2, 3, 4, 5, 6};
+  std::list<int> L{1, 2, 3};
+  auto sq = [](int i) { return i * i; };
+
+  // Adapters of lvalues are sized, borrowed views
+  auto check = []<typename R>(R &&) {
+    static_assert(std::ranges::view<std::remove_cvref_t<R>>);
+    static_assert(std::ranges::sized_range<R>);
+    static_assert(std::ranges::borrowed_range<R>);
+  };
+  check(range(5));
+  check(product_range(2, 3));
+  check(transform(V, sq));
+  check(enumerate(V));
+  check(zip(V, L));
+  check(product(V, L));
+  check(slice(L, 1, 2));
+  check(stride(V, 2));
+  check(tiled_product<2>(V));
+
+  static_assert(std::ranges::random_access_range<decltype(zip(V, range(6)))>);
+  static_assert(std::ranges::bidirectional_range<decltype(enumerate(L))>);
+  static_assert(not std::ranges::random_access_range<decltype(enumerate(L))>);
+
+  // Adapters of unsized ranges are not sized, whatever they could compute in linear time
+  std::forward_list<int> F{1, 2, 3};
+  static_assert(not std::ranges::sized_range<decltype(product(V, F))>);
+  static_assert(not std::ranges::sized_range<decltype(stride(F, 2))>);
+  static_assert(not std::ranges::sized_range<decltype(zip(V, F))>);
+  EXPECT_EQ(std::ranges::distance(product(V, F)), 18);
+  EXPECT_EQ(std::ranges::distance(stride(F, 2)), 2);
+
+  // Adapters owning a container are neither views nor borrowed
+  static_assert(not std::ranges::view<decltype(zip(std::vector<int>{}, V))>);
+  static_assert(not std::ranges::borrowed_range<decltype(enumerate(std::vector<int>{}))>);
+  static_assert(std::ranges::borrowed_range<decltype(zip(range(3), V))>);
+
+  // Composition with the standard views
+  std::vector<long> res;
+  for (auto [i, x] : enumerate(V) | std::views::drop(2) | std::views::take(3)) res.push_back(i * x);
+  EXPECT_EQ(res, (std::vector<long>{6, 12, 20}));
+
+  res.clear();
+  for (auto x : transform(V, sq) | std::views::reverse) res.push_back(x);
+  EXPECT_EQ(res, (std::vector<long>{36, 25, 16, 9, 4, 1}));
+
+  auto z = zip(V, L);
+  EXPECT_EQ(std::ranges::distance(z), 3);
+  EXPECT_EQ(std::ranges::size(product(V, L)), 18);
+  EXPECT_EQ(std::ranges::count_if(range(10), [](long i) { return i % 3 == 0; }), 4);
+
+  // Iterators of a borrowed range outlive the adapter
+  auto it = std::ranges::find_if(zip(V, L), [](auto t) { return std::get<1>(t) == 2; });
+  EXPECT_EQ(std::get<0>(*it), 2);
+}
+
 TEST(Itertools, Transform) {
 
   std::vector<int> V{1, 2, 3, 4, 5, 6};
@@ -92,6 +263,33 @@ TEST(Itertools, Transform) {
     ++i;
     EXPECT_TRUE(i * i == x);
   }
+
+  // Stateless lambdas take no space in the iterator, others are copied into it
+  auto t = transform(range(6), l);
+  static_assert(sizeof(t.begin()) == sizeof(range(6).begin()));
+  int a   = 3;
+  auto ta = transform(range(6), [a](long j) { return a * j; });
+  static_assert(std::ranges::borrowed_range<decltype(ta)>);
+  EXPECT_EQ(make_vector_from_range(ta), (std::vector<long>{0, 3, 6, 9, 12, 15}));
+
+  // Iterators stay valid when the transformed range is gone
+  auto it_ta = transform(range(6), [a](long j) { return a * j; }).begin();
+  EXPECT_EQ(it_ta[4], 12);
+
+  // Collecting an adapter with a sentinel reserves its size up front
+  EXPECT_EQ(make_vector_from_range(ta).capacity(), 6);
+  EXPECT_EQ(make_vector_from_range(transform(product_range(3, 5), [](auto idx) { return std::get<0>(idx); })).capacity(), 15);
+
+  // A mutable lambda keeps its state per iterator
+  auto count = transform(V, [n = 0](int) mutable { return n++; });
+  auto it1   = count.begin();
+  auto it2   = count.begin();
+  EXPECT_EQ(*it1, 0);
+  EXPECT_EQ(*it1, 1);
+  EXPECT_EQ(*it2, 0);
+  it2 = it1;
+  EXPECT_EQ(*it2, 2);
+  EXPECT_EQ(*it1, 2);
 }
 
 TEST(Itertools, Product) {
@@ -105,6 +303,137 @@ TEST(Itertools, Product) {
   std::vector<int> V4{1, 1, 1, 1};
   for (auto [x, y] : product(V3, V4)) { y *= x; }
   EXPECT_EQ(V4, std::vector<int>(4, 1 * 2 * 3 * 4));
+
+  // A product with an empty component is empty, whatever its position
+  std::vector<int> E;
+  std::list<int> L{1, 2};
+  long count = 0;
+  for ([[maybe_unused]] auto [x, y, z] : product(V1, E, V3)) ++count;
+  for ([[maybe_unused]] auto [x, y] : product(L, E)) ++count;
+  EXPECT_EQ(count, 0);
+  auto pe = product(V1, V3, E);
+  EXPECT_EQ(pe.size(), 0);
+  EXPECT_TRUE(pe.begin() == pe.end());
+  EXPECT_EQ(pe.end() - pe.begin(), 0);
+  EXPECT_TRUE(pe.begin() + 0 == pe.end());
+  EXPECT_TRUE(make_vector_from_range(pe).empty());
+}
+
+TEST(Itertools, Product_Random_Access) {
+
+  std::vector<int> V1{0, 1, 2};
+  std::vector<int> V2{0, 1, 2, 3};
+  std::array<int, 5> V3{0, 1, 2, 3, 4};
+  auto p = product(V1, V2, V3);
+
+  using iter_t = decltype(p.begin());
+  static_assert(std::is_same_v<std::iterator_traits<iter_t>::iterator_category, std::random_access_iterator_tag>);
+
+  EXPECT_EQ(p.size(), 3 * 4 * 5);
+  EXPECT_EQ(itertools::distance(p.begin(), p.end()), 3 * 4 * 5);
+
+  // Jumping to a linear index agrees with stepwise iteration
+  long n = 0;
+  for (auto it = p.begin(); it != p.end(); ++it, ++n) {
+    EXPECT_EQ(*it, *(p.begin() + n));
+    EXPECT_EQ(*it, p.begin()[n]);
+    EXPECT_EQ(it - p.begin(), n);
+    EXPECT_EQ(p.end() - it, p.size() - n);
+  }
+
+  auto it = p.begin() + 27;
+  EXPECT_EQ(*it, std::make_tuple(1, 1, 2));
+  it -= 13;
+  EXPECT_EQ(*it, std::make_tuple(0, 2, 4));
+  --it;
+  EXPECT_EQ(*it, std::make_tuple(0, 2, 3));
+  EXPECT_TRUE(p.begin() < it);
+  EXPECT_TRUE(p.begin() + p.size() == p.end());
+}
+
+TEST(Itertools, Iterator_Category) {
+
+  std::vector<int> V{1, 2, 3, 4, 5, 6};
+  std::list<int> L{1, 2, 3, 4, 5, 6};
+  auto sq = [](int i) { return i * i; };
+
+  using ra_t   = std::random_access_iterator_tag;
+  using bidi_t = std::bidirectional_iterator_tag;
+  auto cat     = [](auto const &r) { return typename std::iterator_traits<decltype(r.begin())>::iterator_category{}; };
+
+  static_assert(std::is_same_v<decltype(cat(enumerate(V))), ra_t>);
+  static_assert(std::is_same_v<decltype(cat(transform(V, sq))), ra_t>);
+  static_assert(std::is_same_v<decltype(cat(zip(V, V))), ra_t>);
+  static_assert(std::is_same_v<decltype(cat(stride(V, 2))), ra_t>);
+  static_assert(std::is_same_v<decltype(cat(enumerate(L))), bidi_t>);
+  static_assert(std::is_same_v<decltype(cat(zip(V, L))), bidi_t>);
+  static_assert(std::is_same_v<decltype(cat(product(L, L))), bidi_t>);
+
+  // Binary search over a transformed range
+  auto squares = transform(V, sq);
+  auto it      = std::lower_bound(squares.begin(), squares.begin() + 6, 16);
+  EXPECT_EQ(it - squares.begin(), 3);
+  EXPECT_EQ(squares.begin()[4], 25);
+  EXPECT_EQ(itertools::distance(squares.begin(), squares.end()), 6);
+
+  // Random access into enumerate and zip
+  auto e = enumerate(V);
+  EXPECT_EQ(std::get<0>(*(e.begin() + 3)), 3);
+  EXPECT_EQ(std::get<1>(*(e.begin() + 3)), 4);
+  EXPECT_EQ(e.end() - e.begin(), 6);
+
+  std::vector<int> W{6, 5, 4, 3};
+  auto z = zip(V, W);
+  EXPECT_EQ(itertools::distance(z.begin(), z.end()), 4);
+  EXPECT_EQ(*(z.begin() + 2), std::make_tuple(3, 4));
+
+  // Walk backwards over bidirectional adapters
+  auto zl   = zip(L, V);
+  auto last = std::next(zl.begin(), 5);
+  EXPECT_EQ(*std::prev(last, 2), std::make_tuple(4, 4));
+
+  auto pl = product(L, L);
+  auto pi = std::next(pl.begin(), 12);
+  EXPECT_EQ(*pi, std::make_tuple(3, 1));
+  --pi;
+  EXPECT_EQ(*pi, std::make_tuple(2, 6));
+  std::advance(pi, -5);
+  EXPECT_EQ(*pi, std::make_tuple(2, 1));
+}
+
+TEST(Itertools, Stride) {
+
+  std::vector<int> V{0, 1, 2, 3, 4, 5, 6};
+
+  for (long s : range(1, 9)) {
+    auto st = stride(V, s);
+    std::vector<int> expected;
+    for (long i = 0; i < 7; i += s) expected.push_back(i);
+
+    EXPECT_EQ(st.size(), expected.size());
+    EXPECT_EQ(st.end() - st.begin(), expected.size());
+    EXPECT_EQ(make_vector_from_range(st), expected);
+
+    // Iterate backwards from the end
+    std::vector<int> backwards;
+    for (auto it = st.end(); it != st.begin();) backwards.push_back(*--it);
+    EXPECT_TRUE(std::equal(backwards.rbegin(), backwards.rend(), expected.begin(), expected.end()));
+
+    for (long n : range(expected.size())) EXPECT_EQ(st.begin()[n], expected[n]);
+  }
+
+  // The stride of an integer range is again a range
+  for (long s : range(1, 9)) {
+    for (auto r : {range(7), range(2, 11, 3), range(10, -3, -2), range(4, 4)}) {
+      auto st = stride(r, s);
+      static_assert(std::is_same_v<decltype(st), range>);
+      std::vector<long> expected;
+      for (long i = 0; i < r.size(); i += s) expected.push_back(r.first() + i * r.step());
+      EXPECT_EQ(st.size(), expected.size());
+      EXPECT_EQ(make_vector_from_range(st), expected);
+    }
+  }
+  EXPECT_THROW(stride(range(5), 0), std::runtime_error);
 }
 
 TEST(Itertools, Slice) {
@@ -116,9 +445,85 @@ TEST(Itertools, Slice) {
         long sum     = std::accumulate(sliced.cbegin(), sliced.cend(), 0);
         long end_idx = std::max(std::min(M, N), start_idx);
         EXPECT_EQ(sum, end_idx * (end_idx - 1) / 2 - start_idx * (start_idx - 1) / 2);
+        EXPECT_EQ(sliced.size(), end_idx - start_idx);
+        EXPECT_EQ(sliced.end() - sliced.begin(), end_idx - start_idx);
+        static_assert(std::is_same_v<decltype(sliced), range>);
       }
     }
   }
+
+  // Slices of ranges with a step
+  EXPECT_EQ(slice(range(2, 20, 3), 1, 4), range(5, 14, 3));
+  EXPECT_EQ(make_vector_from_range(slice(range(10, 0, -2), 1, 3)), (std::vector<long>{8, 6}));
+  EXPECT_EQ(slice(range(5), 4, 2).size(), 0);
+  EXPECT_EQ(slice(range(5), -3, 2).size(), 2);
+
+  // Bounds beyond the end of the underlying range are clamped
+  std::list<int> L{0, 1, 2, 3, 4};
+  auto sl = slice(L, 6, 10);
+  EXPECT_EQ(sl.size(), 0);
+  EXPECT_TRUE(sl.begin() == sl.end());
+  EXPECT_EQ(make_vector_from_range(slice(L, 2, 10)), (std::vector<int>{2, 3, 4}));
+
+  // and so are bounds before its beginning
+  std::vector<int> V{0, 1, 2, 3, 4};
+  auto sv = slice(V, -3, 2);
+  EXPECT_EQ(sv.size(), 2);
+  EXPECT_TRUE(sv.begin() == V.begin());
+  EXPECT_EQ(make_vector_from_range(sv), (std::vector<int>{0, 1}));
+  EXPECT_EQ(slice(V, -3, -1).size(), 0);
+
+  // Slices of products jump directly to their bounds
+  auto sp = slice(product_range(4, 5), 7, 13);
+  EXPECT_EQ(sp.size(), 6);
+  EXPECT_EQ(*sp.begin(), std::make_tuple(1, 2));
+  EXPECT_EQ(*std::prev(sp.end()), std::make_tuple(2, 2));
+}
+
+TEST(Itertools, Pipe) {
+
+  std::vector<int> a{1, 2, 3, 4, 5, 6, 7, 8}, b{8, 7, 6, 5, 4, 3, 2, 1};
+  auto sq  = [](int i) { return i * i; };
+  auto inc = [](int i) { return i + 1; };
+  auto mul = [](auto t) {
+    auto [x, y] = t;
+    return x * y;
+  };
+
+  // A pipeline is equivalent to nested calls
+  auto p = zip(a, b) | stride(2) | slice(0, 3) | transform(mul);
+  EXPECT_EQ(make_vector_from_range(p), make_vector_from_range(transform(slice(stride(zip(a, b), 2), 0, 3), mul)));
+  EXPECT_EQ(make_vector_from_range(p), (std::vector<int>{8, 18, 20}));
+
+  // transform of transform composes the lambdas
+  auto t = a | transform(sq) | transform(inc);
+  static_assert(std::is_same_v<decltype(t), detail::transformed<std::vector<int> &, detail::composed<decltype(sq), decltype(inc)>>>);
+  EXPECT_EQ(make_vector_from_range(t), make_vector_from_range(transform(transform(a, sq), inc)));
+
+  // slice of slice and stride of stride are combined
+  auto s = a | slice(1, 7) | slice(2, 10);
+  static_assert(std::is_same_v<decltype(s), detail::sliced<std::vector<int> &>>);
+  EXPECT_EQ(make_vector_from_range(s), (std::vector<int>{4, 5, 6, 7}));
+  EXPECT_EQ(make_vector_from_range(a | slice(5, 2) | slice(0, 1)).size(), 0);
+
+  auto st = a | stride(2) | stride(3);
+  static_assert(std::is_same_v<decltype(st), detail::strided<std::vector<int> &>>);
+  EXPECT_EQ(make_vector_from_range(st), (std::vector<int>{1, 7}));
+
+  // slice and stride of a range are a range
+  auto r = range(0, 20, 3) | slice(1, 5) | stride(2);
+  static_assert(std::is_same_v<decltype(r), range>);
+  EXPECT_EQ(r, range(3, 15, 6));
+  EXPECT_EQ(make_vector_from_range(range(10, 0, -2) | slice(1, 3)), (std::vector<long>{8, 6}));
+  EXPECT_EQ((range(5) | slice(3, 100)).size(), 2);
+  EXPECT_EQ((range(5) | stride(2)).size(), 3);
+
+  // enumerate and owning adapters
+  std::vector<std::tuple<long, int>> res;
+  for (auto [i, x] : a | stride(4) | enumerate()) res.emplace_back(i, x);
+  EXPECT_EQ(res, (std::vector<std::tuple<long, int>>{{0, 1}, {1, 5}}));
+  auto owned = slice(std::vector<int>{1, 2, 3, 4}, 1, 4);
+  EXPECT_EQ(make_vector_from_range(owned | slice(1, 2)), (std::vector<int>{3}));
 }
 
 TEST(Itertools, Make_Product) {
@@ -192,6 +597,49 @@ TEST(Itertools, Range) {
   EXPECT_EQ(range(-1, 0, -3).size(), 0);
   EXPECT_EQ(range(10, -10, 2).size(), 0);
   EXPECT_EQ(range(-10, 10, -2).size(), 0);
+
+  // Empty ranges in a product, at any position, must not be stepped past their end
+  long count = 0;
+  for ([[maybe_unused]] auto [i, j] : product(range(3), range(0))) ++count;
+  for ([[maybe_unused]] auto [i, j] : product(range(0), range(3))) ++count;
+  for ([[maybe_unused]] auto [i, j, k] : product(range(2), range(5, 5), range(4))) ++count;
+  EXPECT_EQ(count, 0);
+  EXPECT_EQ(make_vector_from_range(product(range(3), range(0))).size(), 0);
+}
+
+TEST(Itertools, Range_Random_Access) {
+
+  using iter_t = range::const_iterator;
+  static_assert(std::is_same_v<std::iterator_traits<iter_t>::iterator_category, std::random_access_iterator_tag>);
+
+  for (auto r : {range(0, 10), range(-3, 8, 3), range(10, -10, -2), range(5, 1, -3), range(4, 4), range(10, 0)}) {
+    EXPECT_EQ(r.end() - r.begin(), r.size());
+    EXPECT_EQ(itertools::distance(r.begin(), r.end()), r.size());
+    EXPECT_TRUE(std::next(r.begin(), r.size()) == r.end());
+
+    long n = 0;
+    for (auto i : r) {
+      EXPECT_EQ(r.begin()[n], i);
+      EXPECT_EQ(*(r.begin() + n), i);
+      EXPECT_EQ(*(r.end() - (r.size() - n)), i);
+      ++n;
+    }
+    EXPECT_EQ(n, r.size());
+  }
+
+  auto r  = range(1, 20, 4);
+  auto it = r.begin();
+  it += 3;
+  EXPECT_EQ(*it, 13);
+  EXPECT_EQ(*--it, 9);
+  EXPECT_TRUE(r.begin() < it and it < r.end());
+  EXPECT_EQ(*std::lower_bound(r.begin(), r.end(), 10), 13);
+
+  // Products of ranges are random-access as well
+  auto p = product_range(3, 4, 5);
+  static_assert(std::is_same_v<std::iterator_traits<decltype(p.begin())>::iterator_category, std::random_access_iterator_tag>);
+  EXPECT_EQ(p.end() - p.begin(), 60);
+  EXPECT_EQ(*(p.begin() + 27), std::make_tuple(1, 1, 2));
 }
 
 TEST(Itertools, Product_Range) {
@@ -199,6 +647,138 @@ TEST(Itertools, Product_Range) {
   long res = 0;
   for (auto [i, j, k] : product_range(5, 5, 5)) res += i * j * k;
   EXPECT_EQ(res, 1000);
+
+  // Same sequence as the product of the individual ranges
+  auto pr = product_range(std::make_tuple(3, 2l, 4));
+  EXPECT_EQ(pr.size(), 24);
+  EXPECT_EQ(make_vector_from_range(pr), make_vector_from_range(product(range(3), range(2), range(4))));
+  auto expected = std::vector<std::tuple<long, long>>{{0, 0}, {0, 1}, {0, 2}, {1, 0}, {1, 1}, {1, 2}};
+  EXPECT_EQ(make_vector_from_range(product_range(std::array{2, 3})), expected);
+
+  // Walk backwards
+  std::vector<std::tuple<long, long, long>> backwards;
+  for (auto it = pr.begin() + pr.size(); it != pr.begin();) backwards.push_back(*--it);
+  std::reverse(backwards.begin(), backwards.end());
+  EXPECT_EQ(backwards, make_vector_from_range(pr));
+
+  // Empty extents yield an empty product
+  EXPECT_EQ(product_range(3, 0, 2).size(), 0);
+  EXPECT_TRUE(product_range(3, 0, 2).begin() == product_range(3, 0, 2).end());
+  EXPECT_EQ(product_range(-1, 2).size(), 0);
+}
+
+TEST(Itertools, Product_Range_Static) {
+
+  auto ps = product_range<2, 3, 5>();
+  static_assert(sizeof(ps) == 1);
+  static_assert(product_range<2, 3, 5>().size() == 30);
+  static_assert(product_range<2, 3, 5>().extents() == std::array<long, 3>{2, 3, 5});
+
+  // The full iteration can be evaluated at compile-time
+  constexpr long sum = [] {
+    long res = 0;
+    for (auto [i, j, k] : product_range<2, 3, 5>()) res += i * 100 + j * 10 + k;
+    return res;
+  }();
+  long expected = 0;
+  for (auto [i, j, k] : product_range(2, 3, 5)) expected += i * 100 + j * 10 + k;
+  EXPECT_EQ(sum, expected);
+
+  EXPECT_EQ(make_vector_from_range(ps), make_vector_from_range(product_range(ps.extents())));
+  EXPECT_EQ(make_vector_from_range(ps), make_vector_from_range(make_product(std::array{range(2), range(3), range(5)})));
+
+  auto pc = product_range(std::integral_constant<int, 2>{}, std::integral_constant<long, 3>{});
+  static_assert(std::is_same_v<decltype(pc), decltype(product_range<2, 3>())>);
+  EXPECT_EQ(*(pc.begin() + 4), std::make_tuple(1, 1));
+}
+
+TEST(Itertools, Collect_Soa) {
+
+  // One contiguous vector per component of a product range
+  auto [is, js] = collect_soa(product_range(2, 3));
+  EXPECT_EQ(is, (std::vector<long>{0, 0, 0, 1, 1, 1}));
+  EXPECT_EQ(js, (std::vector<long>{0, 1, 2, 0, 1, 2}));
+  EXPECT_EQ(is.capacity(), 6);
+
+  // The components of a zip are stored by value
+  std::vector<int> a{1, 2, 3};
+  std::list<double> b{0.5, 1.5, 2.5};
+  auto cols = collect_soa(zip(a, b));
+  static_assert(std::is_same_v<decltype(cols), std::tuple<std::vector<int>, std::vector<double>>>);
+  a[0] = 10;
+  EXPECT_EQ(std::get<0>(cols), (std::vector<int>{1, 2, 3}));
+
+  // The matching zip view iterates over all components and can modify them
+  for (auto [x, y] : zip_soa(cols)) y += x;
+  EXPECT_EQ(std::get<1>(cols), (std::vector<double>{1.5, 3.5, 5.5}));
+  static_assert(std::ranges::random_access_range<decltype(zip_soa(cols))>);
+  EXPECT_EQ(zip_soa(std::as_const(cols)).size(), 3);
+}
+
+TEST(Itertools, Weighted_Chunk_Range) {
+
+  // Uniform costs reproduce the chunks of chunk_range up to rounding
+  auto uniform = cost_model(100, [](long) { return 1.0; });
+  EXPECT_EQ(uniform.total(), 100.0);
+  for (long rank : range(4)) EXPECT_EQ(weighted_chunk_range(uniform, 4, rank), chunk_range(0, 100, 4, rank));
+
+  // Linearly growing costs, the chunks cover the range and shrink with the rank
+  long N        = 1000;
+  auto linear   = cost_model(N, [](long i) { return double(i); });
+  long n_chunks = 5, prev_end = 0, prev_size = N;
+  for (long rank : range(n_chunks)) {
+    auto [start, end] = weighted_chunk_range(linear, n_chunks, rank);
+    EXPECT_EQ(start, prev_end);
+    EXPECT_LT(end - start, prev_size);
+    double cost = linear.prefix_sums()[end] - linear.prefix_sums()[start];
+    EXPECT_NEAR(cost, linear.total() / n_chunks, N);
+    prev_end  = end;
+    prev_size = end - start;
+  }
+  EXPECT_EQ(prev_end, N);
+
+  // Direct version on an integer range
+  auto [start, end] = weighted_chunk_range(10, 20, [](long i) { return i < 16 ? 1 : 0; }, 2, 1);
+  EXPECT_EQ(start, 13);
+  EXPECT_EQ(end, 20);
+
+  // More chunks than positions
+  auto small = cost_model(std::vector<double>{0.0, 1.0, 2.0});
+  long total = 0;
+  for (long rank : range(5)) {
+    auto [s, e] = weighted_chunk_range(small, 5, rank);
+    total += e - s;
+  }
+  EXPECT_EQ(total, 2);
+  EXPECT_THROW(cost_model(std::vector<double>{}), std::runtime_error);
+}
+
+TEST(Itertools, Tiled_Product) {
+
+  // Same elements as the plain product, each exactly once
+  for (auto [N, M] : std::vector<std::pair<long, long>>{{7, 5}, {8, 8}, {1, 9}, {0, 3}}) {
+    for (auto tiles : {std::array{2l, 3l}, std::array{4l, 4l}, std::array{1l, 10l}}) {
+      auto t   = tiled_product(tiles, range(N), range(M));
+      auto vec = make_vector_from_range(t);
+      EXPECT_EQ(long(vec.size()), N * M);
+      EXPECT_EQ(t.size(), N * M);
+      std::sort(vec.begin(), vec.end());
+      EXPECT_EQ(vec, make_vector_from_range(product_range(N, M)));
+    }
+  }
+
+  // Order of visit for a 3x3 index space with 2x2 tiles
+  using v_t     = std::vector<std::tuple<long, long>>;
+  auto expected = v_t{{0, 0}, {0, 1}, {1, 0}, {1, 1}, {0, 2}, {1, 2}, {2, 0}, {2, 1}, {2, 2}};
+  EXPECT_EQ(make_vector_from_range(tiled_product<2, 2>(range(3), range(3))), expected);
+
+  // Arbitrary random-access ranges, elements can be modified
+  std::vector<int> V{1, 2, 3};
+  std::array<int, 4> W{1, 1, 1, 1};
+  for (auto [x, y] : tiled_product<2, 2>(V, W)) y *= x;
+  EXPECT_EQ(W, (std::array<int, 4>{6, 6, 6, 6}));
+
+  EXPECT_THROW(tiled_product(std::array{0l}, range(3)), std::runtime_error);
 }
 
 int main(int argc, char **argv) {
@@ -0,0 +1,77 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <itertools/mpi_chunk.hpp>
+
+#include <vector>
+
+using namespace itertools;
+
+// Sum of a long over all ranks
+long all_reduce_sum(long x, MPI_Comm comm = MPI_COMM_WORLD) {
+  long res = 0;
+  MPI_Allreduce(&x, &res, 1, MPI_LONG, MPI_SUM, comm);
+  return res;
+}
+
+TEST(MPI, Chunk) {
+
+  for (long N : {0, 3, 100, 1001}) {
+    long count = 0, sum = 0;
+    for (long i : mpi_chunk(range(N))) {
+      ++count;
+      sum += i;
+    }
+    EXPECT_EQ(all_reduce_sum(count), N);
+    EXPECT_EQ(all_reduce_sum(sum), N * (N - 1) / 2);
+  }
+
+  // Chunk a zip of two vectors known on all ranks
+  std::vector<long> a(50, 2), b(50, 3);
+  long dot = 0;
+  for (auto [x, y] : mpi_chunk(zip(a, b))) dot += x * y;
+  EXPECT_EQ(all_reduce_sum(dot), 300);
+}
+
+TEST(MPI, HybridChunk) {
+
+  long N = 20, count = 0, sum = 0;
+#pragma omp parallel reduction(+ : count, sum)
+  for (auto [i, j, k] : mpi_omp_chunk(product_range(N, N, N))) {
+    ++count;
+    sum += i * N * N + j * N + k;
+  }
+  EXPECT_EQ(all_reduce_sum(count), N * N * N);
+  EXPECT_EQ(all_reduce_sum(sum), N * N * N * (N * N * N - 1) / 2);
+
+  // Consecutive calls in a region query their own communicator
+  long count_world = 0, count_self = 0;
+#pragma omp parallel reduction(+ : count_world, count_self)
+  {
+    for ([[maybe_unused]] long i : mpi_omp_chunk(range(N), MPI_COMM_WORLD)) ++count_world;
+    for ([[maybe_unused]] long i : mpi_omp_chunk(range(N), MPI_COMM_SELF)) ++count_self;
+  }
+  EXPECT_EQ(all_reduce_sum(count_world), N);
+  EXPECT_EQ(count_self, N);
+}
+
+int main(int argc, char **argv) {
+  int provided = 0;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+  ::testing::InitGoogleTest(&argc, argv);
+  int res = RUN_ALL_TESTS();
+  MPI_Finalize();
+  return res;
+}
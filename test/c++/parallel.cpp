@@ -0,0 +1,224 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <itertools/parallel.hpp>
+#include <itertools/numa.hpp>
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace itertools;
+
+// Run a test for each of the OpenMP scheduling policies
+template <typename F> void for_each_schedule(F f) {
+  f(omp_static);
+  f(omp_static_t{3});
+  f(omp_dynamic);
+  f(omp_dynamic_t{7});
+  f(omp_guided);
+  f(omp_guided_t{5});
+  f(work_stealing);
+  f(work_stealing_t{4});
+}
+
+TEST(Parallel, For) {
+
+  for_each_schedule([](auto sched) {
+    long N = 1000;
+    std::vector<long> V(N, 0);
+    parallel_for(range(N), [&](long i) { V[i] += i; }, sched);
+    for (long i : range(N)) EXPECT_EQ(V[i], i);
+
+    std::vector<long> M(20 * 30, 0);
+    parallel_for(product_range(20, 30), [&](auto idx) {
+      auto [i, j] = idx;
+      M[i * 30 + j] += i - j;
+    }, sched);
+    for (auto [i, j] : product_range(20, 30)) EXPECT_EQ(M[i * 30 + j], i - j);
+
+    std::vector<long> W(N, 0);
+    parallel_for(zip(V, W), [](auto x) { std::get<1>(x) = 2 * std::get<0>(x); }, sched);
+    for (long i : range(N)) EXPECT_EQ(W[i], 2 * i);
+
+    parallel_for(enumerate(W), [](auto x) { std::get<1>(x) += std::get<0>(x); }, sched);
+    for (long i : range(N)) EXPECT_EQ(W[i], 3 * i);
+
+    parallel_for(slice(V, 100, 200), [](long &x) { x = -x; }, sched);
+    for (long i : range(N)) EXPECT_EQ(V[i], (i >= 100 and i < 200) ? -i : i);
+  });
+
+  // Ranges without random access are split statically
+  std::list<long> L(100, 1);
+  parallel_for(L, [](long &x) { x += omp_get_thread_num() >= 0; });
+  EXPECT_TRUE(std::all_of(L.begin(), L.end(), [](long x) { return x == 2; }));
+}
+
+TEST(Parallel, Reduce) {
+
+  for_each_schedule([](auto sched) {
+    long N   = 10000;
+    auto sum = parallel_reduce(range(N), 0l, std::plus<>{}, [](long i) { return i; }, sched);
+    EXPECT_EQ(sum, N * (N - 1) / 2);
+
+    auto psum = parallel_reduce(product_range(40, 50), 7l, std::plus<>{}, [](auto idx) { return std::get<0>(idx) * std::get<1>(idx); }, sched);
+    EXPECT_EQ(psum, 7 + (39 * 40 / 2) * (49 * 50 / 2));
+
+    std::vector<double> a(N, 0.5), b(N, 4.0);
+    auto dot = parallel_reduce(zip(a, b), 0.0, std::plus<>{}, [](auto x) { return std::get<0>(x) * std::get<1>(x); }, sched);
+    EXPECT_DOUBLE_EQ(dot, 2.0 * N);
+
+    auto max = parallel_reduce(range(-N, N), -N, [](long x, long y) { return std::max(x, y); }, [](long i) { return i * i % 1009; }, sched);
+    EXPECT_EQ(max, 1008);
+  });
+
+  // Empty range yields the initial value
+  EXPECT_EQ(parallel_reduce(range(0), 42l, std::plus<>{}, [](long i) { return i; }), 42);
+
+  std::list<long> L(100, 3);
+  EXPECT_EQ(parallel_reduce(L, 0l, std::plus<>{}, [](long x) { return x; }), 300);
+}
+
+TEST(Parallel, WorkStealing) {
+
+  // Triangular workload, the cost of a point grows with its row index
+  long N = 200;
+  std::vector<long> M(N * N, 0);
+  parallel_for(product_range(N, N), [&](auto idx) {
+    auto [i, j] = idx;
+    long res    = 0;
+    for (long k = 0; k < i * j; ++k) res += k % 3;
+    M[i * N + j] = res;
+  }, work_stealing);
+  for (auto [i, j] : product_range(N, N)) EXPECT_EQ(M[i * N + j], (i * j / 3) * 3 + (i * j % 3 == 2));
+
+  auto count = parallel_reduce(slice(range(1000), 10, 990), 0l, std::plus<>{}, [](long) { return 1l; }, work_stealing_t{1});
+  EXPECT_EQ(count, 980);
+}
+
+TEST(Parallel, DynamicChunks) {
+
+  for (long grain : {1, 4, 100, 10000}) {
+    long N = 2000;
+    std::vector<std::atomic<int>> visits(N);
+
+    // Every element is visited exactly once, with skewed work per element
+#pragma omp parallel
+    for (long i : omp_dynamic_chunks(range(N), grain)) {
+      long res = 0;
+      for (long k = 0; k < i; ++k) res += k;
+      if (res >= 0) ++visits[i];
+    }
+    for (auto &v : visits) EXPECT_EQ(v, 1);
+
+    std::vector<long> M(40 * 50, 0);
+#pragma omp parallel
+    for (auto [i, j] : omp_dynamic_chunks(product_range(40, 50), grain)) M[i * 50 + j] += i + j;
+    for (auto [i, j] : product_range(40, 50)) EXPECT_EQ(M[i * 50 + j], i + j);
+  }
+
+  // Outside of a parallel region the full range is visited
+  long sum = 0;
+  for (auto [n, x] : omp_dynamic_chunks(enumerate(std::vector<long>(10, 2)))) sum += n * x;
+  EXPECT_EQ(sum, 90);
+}
+
+TEST(Parallel, Numa) {
+
+  EXPECT_EQ(detail::parse_cpu_list("0-3,8,10-11\n"), (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+  EXPECT_EQ(detail::parse_cpu_list(""), std::vector<int>{});
+
+  auto const &topo = numa_topology::get();
+  EXPECT_GE(topo.n_nodes(), 1);
+  EXPECT_GE(current_numa_node(), 0);
+  EXPECT_LT(current_numa_node(), topo.n_nodes());
+
+  // The chunks cover the range exactly once
+  long N = 1001;
+  std::vector<std::atomic<int>> visits(N);
+#pragma omp parallel
+  for (long i : omp_numa_chunk(range(N))) ++visits[i];
+  for (auto &v : visits) EXPECT_EQ(v, 1);
+
+  // First-touch initialization with the same split
+  auto buffer = std::make_unique_for_overwrite<double[]>(N);
+  omp_numa_first_touch(std::span{buffer.get(), size_t(N)}, 3.0);
+  EXPECT_TRUE(std::all_of(buffer.get(), buffer.get() + N, [](double x) { return x == 3.0; }));
+}
+
+TEST(Parallel, MakeVector) {
+
+  auto f = [](auto idx) {
+    auto [i, j] = idx;
+    return std::to_string(i) + "," + std::to_string(j);
+  };
+  auto t = transform(product_range(13, 17), f);
+  auto v = parallel_make_vector_from_range(t);
+  static_assert(std::is_same_v<decltype(v), decltype(make_vector_from_range(t))>);
+  EXPECT_EQ(v, make_vector_from_range(t));
+  EXPECT_EQ(v.size(), 13 * 17);
+
+  // Elements neither need to be default-constructible nor assignable
+  struct tagged {
+    long const i;
+    std::string const s;
+  };
+  auto u = parallel_make_vector_from_range(transform(range(100), [](long i) { return tagged{i, std::to_string(i)}; }));
+  ASSERT_EQ(u.size(), 100);
+  for (long i : range(100)) EXPECT_EQ(u[i].s, std::to_string(i));
+
+  auto sq = parallel_make_vector_from_range(transform(range(1000), [](long i) { return double(i * i); }));
+  for (long i : range(1000)) EXPECT_EQ(sq[i], double(i * i));
+  EXPECT_TRUE(parallel_make_vector_from_range(range(0)).empty());
+}
+
+TEST(Parallel, ChunkRange) {
+
+  // Chunks of an integer range are ranges, which together cover the range with its step
+  auto r = range(3, 500, 7);
+  std::vector<std::atomic<int>> visits(500);
+#pragma omp parallel
+  {
+    auto chunk = omp_chunk(r);
+    static_assert(std::is_same_v<decltype(chunk), range>);
+    EXPECT_EQ(chunk.step(), 7);
+    for (long i : chunk) ++visits[i];
+  }
+  for (long i : range(500)) EXPECT_EQ(visits[i], (i >= 3 and (i - 3) % 7 == 0) ? 1 : 0);
+}
+
+TEST(Parallel, WeightedChunk) {
+
+  long N     = 500;
+  auto costs = cost_model(N, [](long i) { return double(i * i); });
+  std::vector<std::atomic<int>> visits(N);
+
+  // Repeated sweeps with the same cost model
+  for (int sweep = 0; sweep < 3; ++sweep) {
+#pragma omp parallel
+    for (long i : omp_chunk(range(N), costs)) ++visits[i];
+  }
+  for (auto &v : visits) EXPECT_EQ(v, 3);
+
+  EXPECT_THROW(omp_chunk(range(N + 1), costs), std::runtime_error);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
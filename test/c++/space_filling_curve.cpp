@@ -0,0 +1,122 @@
+// Copyright (c) 2024 Simons Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0.txt
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <itertools/space_filling_curve.hpp>
+#include <itertools/omp_chunk.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <tuple>
+#include <vector>
+
+using namespace itertools;
+
+// Check that a curve visits every index of product_range(ext...) exactly once
+template <typename R, typename... Long> void check_permutation(R const &r, Long... ext) {
+  auto vec = make_vector_from_range(r);
+  EXPECT_EQ(long(vec.size()), (ext * ... * 1));
+  std::sort(vec.begin(), vec.end());
+  EXPECT_EQ(vec, make_vector_from_range(product_range(ext...)));
+}
+
+TEST(SpaceFillingCurve, Morton) {
+
+  // Z-order on a 4x4 grid, the last index is the fastest
+  using v_t     = std::vector<std::tuple<long, long>>;
+  auto expected = v_t{{0, 0}, {0, 1}, {1, 0}, {1, 1}, {0, 2}, {0, 3}, {1, 2}, {1, 3}};
+  auto vec      = make_vector_from_range(morton_product_range(4, 4));
+  EXPECT_EQ(v_t(vec.begin(), vec.begin() + 8), expected);
+
+  // Extents which are not powers of two
+  check_permutation(morton_product_range(5l, 3l), 5l, 3l);
+  check_permutation(morton_product_range(7l, 1l, 12l), 7l, 1l, 12l);
+  check_permutation(morton_product_range(100l, 2l), 100l, 2l);
+  check_permutation(morton_product_range(9l), 9l);
+  EXPECT_TRUE(make_vector_from_range(morton_product_range(0, 5)).empty());
+}
+
+TEST(SpaceFillingCurve, Hilbert) {
+
+  // Consecutive indices are neighbours on a power-of-two cube
+  auto vec2 = make_vector_from_range(hilbert_product_range(16, 16));
+  for (size_t n = 1; n < vec2.size(); ++n) {
+    auto [i0, j0] = vec2[n - 1];
+    auto [i1, j1] = vec2[n];
+    EXPECT_EQ(std::abs(i1 - i0) + std::abs(j1 - j0), 1);
+  }
+  auto vec3 = make_vector_from_range(hilbert_product_range(8, 8, 8));
+  for (size_t n = 1; n < vec3.size(); ++n) {
+    auto [i0, j0, k0] = vec3[n - 1];
+    auto [i1, j1, k1] = vec3[n];
+    EXPECT_EQ(std::abs(i1 - i0) + std::abs(j1 - j0) + std::abs(k1 - k0), 1);
+  }
+  EXPECT_EQ(vec2.size(), 256);
+
+  // Extents which are not powers of two
+  check_permutation(hilbert_product_range(5l, 3l), 5l, 3l);
+  check_permutation(hilbert_product_range(6l, 7l, 3l), 6l, 7l, 3l);
+  check_permutation(hilbert_product_range(1l, 1l), 1l, 1l);
+  check_permutation(hilbert_product_range(1024l, 2l), 1024l, 2l);
+  check_permutation(hilbert_product_range(3l, 1l, 40l), 3l, 1l, 40l);
+  EXPECT_TRUE(make_vector_from_range(hilbert_product_range(4, 0)).empty());
+
+  // Each extent is padded separately
+  EXPECT_EQ(hilbert_product_range(1024, 2).cend().it, 2048);
+  EXPECT_EQ(hilbert_product_range(5, 1, 17).cend().it, 8 * 32);
+
+  // A 4x16 rectangle is traversed square by square
+  auto vec_r = make_vector_from_range(hilbert_product_range(4, 16));
+  for (size_t n = 0; n < vec_r.size(); ++n) EXPECT_EQ(std::get<1>(vec_r[n]) / 4, long(n / 16));
+}
+
+TEST(SpaceFillingCurve, Chunk) {
+
+  // The chunks are consecutive pieces of the curve
+  auto r = morton_product_range(10, 6);
+  std::vector<std::tuple<long, long>> joined;
+  for (long rank = 0; rank < 3; ++rank)
+    for (auto idx : r.chunk(3, rank)) joined.push_back(idx);
+  EXPECT_EQ(joined, make_vector_from_range(r));
+
+  // The chunks contain equal numbers of indices, also on skewed grids with padding
+  auto check_balance = [](auto const &c, long n_chunks) {
+    auto all = make_vector_from_range(c);
+    std::vector<std::tuple<long, long>> pieces;
+    for (long rank = 0; rank < n_chunks; ++rank) {
+      auto [start, end] = chunk_range(0, long(all.size()), n_chunks, rank);
+      auto piece        = make_vector_from_range(c.chunk(n_chunks, rank));
+      EXPECT_EQ(long(piece.size()), end - start);
+      pieces.insert(pieces.end(), piece.begin(), piece.end());
+    }
+    EXPECT_EQ(pieces, all);
+  };
+  check_balance(hilbert_product_range(1000, 3), 7);
+  check_balance(hilbert_product_range(5, 33), 4);
+  check_balance(morton_product_range(100, 3), 6);
+  check_balance(hilbert_product_range(2, 2).chunk(3, 1), 2);
+
+  // Split over OMP threads
+  long N = 13;
+  std::vector<std::atomic<int>> visits(N * N * N);
+#pragma omp parallel
+  for (auto [i, j, k] : omp_chunk(hilbert_product_range(N, N, N))) ++visits[(i * N + j) * N + k];
+  for (auto &v : visits) EXPECT_EQ(v, 1);
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}